@@ -0,0 +1,389 @@
+/**
+ * @file bench.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Small harness shared by the benchmark programs
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * This header replaces the global operator new/delete to count allocations,
+ * so it must be included by exactly one translation unit per program.
+ */
+
+#ifndef __DUTCPP_BENCH_H
+#define __DUTCPP_BENCH_H 1
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace bench
+{
+inline std::atomic<std::size_t> allocations{0};
+inline std::atomic<std::size_t> bytes_allocated{0};
+
+/**
+ * @brief Counts and serves one allocation of %n bytes aligned to %align
+ *
+ * Returns nullptr on failure. Every replaced operator new comes here, and
+ * every replaced operator delete goes to counted_free(), so memory from any
+ * overload can be released through any other.
+ */
+inline void *
+counted_alloc(std::size_t n, std::size_t align) noexcept
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes_allocated.fetch_add(n, std::memory_order_relaxed);
+
+    if (n == 0)
+        n = 1;
+
+    if (align <= alignof(std::max_align_t))
+        return std::malloc(n);
+
+    // aligned_alloc() wants a size that is a multiple of the alignment
+    return std::aligned_alloc(align, (n + align - 1) & ~(align - 1));
+}
+
+inline void *
+counted_new(std::size_t n, std::size_t align)
+{
+    if (void *p = counted_alloc(n, align))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+/**
+ * @brief Releases memory from counted_alloc()
+ *
+ * Not inlined, so that the compiler does not see operator new memory going
+ * to std::free() and warn about a mismatch (-Wmismatched-new-delete).
+ */
+[[gnu::noinline]] inline void
+counted_free(void *p) noexcept
+{
+    std::free(p);
+}
+} // namespace bench
+
+// Plain, array, aligned and nothrow forms are all replaced, so that no
+// allocation escapes the counters.
+
+void *
+operator new(std::size_t n)
+{
+    return bench::counted_new(n, alignof(std::max_align_t));
+}
+
+void *
+operator new[](std::size_t n)
+{
+    return bench::counted_new(n, alignof(std::max_align_t));
+}
+
+void *
+operator new(std::size_t n, std::align_val_t align)
+{
+    return bench::counted_new(n, std::size_t(align));
+}
+
+void *
+operator new[](std::size_t n, std::align_val_t align)
+{
+    return bench::counted_new(n, std::size_t(align));
+}
+
+void *
+operator new(std::size_t n, const std::nothrow_t &) noexcept
+{
+    return bench::counted_alloc(n, alignof(std::max_align_t));
+}
+
+void *
+operator new[](std::size_t n, const std::nothrow_t &) noexcept
+{
+    return bench::counted_alloc(n, alignof(std::max_align_t));
+}
+
+void *
+operator new(std::size_t n, std::align_val_t align,
+             const std::nothrow_t &) noexcept
+{
+    return bench::counted_alloc(n, std::size_t(align));
+}
+
+void *
+operator new[](std::size_t n, std::align_val_t align,
+               const std::nothrow_t &) noexcept
+{
+    return bench::counted_alloc(n, std::size_t(align));
+}
+
+void
+operator delete(void *p) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete[](void *p) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete[](void *p, std::size_t) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete(void *p, std::align_val_t) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete[](void *p, std::align_val_t) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete[](void *p, std::size_t, std::align_val_t) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete(void *p, const std::nothrow_t &) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete[](void *p, const std::nothrow_t &) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    bench::counted_free(p);
+}
+
+void
+operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    bench::counted_free(p);
+}
+
+namespace bench
+{
+/**
+ * @brief Keeps the compiler from optimizing away the computation of %value
+ */
+template <typename Tp>
+inline void
+do_not_optimize(const Tp &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Outcome of one measurement
+ */
+struct result
+{
+    double ns_per_op;
+    double allocations_per_rep;
+    double bytes_per_rep;
+    std::size_t reps;
+};
+
+/**
+ * @brief Returns the cost of one pair of clock reads
+ *
+ * Subtracted from every timed region, so that sub-microsecond runs are not
+ * dominated by the clock itself.
+ */
+inline std::chrono::nanoseconds
+clock_overhead()
+{
+    using clock = std::chrono::steady_clock;
+
+    static const std::chrono::nanoseconds overhead = [] {
+        std::chrono::nanoseconds best = std::chrono::nanoseconds::max();
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            const auto t0 = clock::now();
+            const auto t1 = clock::now();
+
+            if (t1 - t0 < best)
+                best = t1 - t0;
+        }
+
+        return best;
+    }();
+
+    return overhead;
+}
+
+/**
+ * @brief Times %run until at least %min_time_ms milliseconds have passed
+ *
+ * Each repetition calls %setup outside of the timed region, then times
+ * %run on the returned state. The state is destroyed outside of the timed
+ * region as well, so %run decides what is measured. %ops is the number of
+ * operations done by one call to %run.
+ */
+template <typename Setup, typename Run>
+result
+measure(std::size_t ops, double min_time_ms, Setup setup, Run run)
+{
+    using clock = std::chrono::steady_clock;
+
+    const auto min_time = std::chrono::duration<double, std::milli>(min_time_ms);
+    const auto overhead = clock_overhead();
+    std::chrono::nanoseconds elapsed{0};
+    std::chrono::nanoseconds total{0};
+    std::size_t reps   = 0;
+    std::size_t allocs = 0;
+    std::size_t bytes  = 0;
+
+    do
+    {
+        auto state = setup();
+
+        const std::size_t a0 = allocations.load(std::memory_order_relaxed);
+        const std::size_t b0 = bytes_allocated.load(std::memory_order_relaxed);
+        const auto t0        = clock::now();
+
+        run(state);
+
+        const auto t1 = clock::now();
+        allocs += allocations.load(std::memory_order_relaxed) - a0;
+        bytes += bytes_allocated.load(std::memory_order_relaxed) - b0;
+        elapsed += t1 - t0;
+        total += (t1 - t0 > overhead) ? t1 - t0 - overhead
+                                      : std::chrono::nanoseconds(0);
+        ++reps;
+    } while (elapsed < min_time);
+
+    return {double(total.count()) / double(reps * (ops ? ops : 1)),
+            double(allocs) / double(reps), double(bytes) / double(reps), reps};
+}
+
+/**
+ * @brief Writes results as a JSON document to stdout
+ *
+ * The output has the shape
+ *
+ *     {"benchmark": "<name>", "results": [{...}, {...}]}
+ *
+ * with one flat object per record.
+ */
+class json_report
+{
+public:
+    explicit json_report(const char *name)
+    {
+        std::printf("{\"benchmark\": \"%s\", \"results\": [", name);
+    }
+
+    json_report(const json_report &)            = delete;
+    json_report &operator=(const json_report &) = delete;
+
+    ~json_report()
+    {
+        std::printf("\n]}\n");
+    }
+
+    void
+    begin_record()
+    {
+        std::printf("%s\n  {", _records++ ? "," : "");
+        _fields = 0;
+    }
+
+    void
+    field(const char *key, const std::string &value)
+    {
+        std::printf("%s\"%s\": \"%s\"", _fields++ ? ", " : "", key,
+                    value.c_str());
+    }
+
+    void
+    field(const char *key, double value)
+    {
+        std::printf("%s\"%s\": %.3f", _fields++ ? ", " : "", key, value);
+    }
+
+    void
+    field(const char *key, std::size_t value)
+    {
+        std::printf("%s\"%s\": %zu", _fields++ ? ", " : "", key, value);
+    }
+
+    void
+    end_record()
+    {
+        std::printf("}");
+        std::fflush(stdout);
+    }
+
+    /**
+     * @brief Writes the fields common to every bench::result
+     */
+    void
+    fields(const result &r)
+    {
+        field("ns_per_op", r.ns_per_op);
+        field("allocations", r.allocations_per_rep);
+        field("bytes_allocated", r.bytes_per_rep);
+        field("reps", r.reps);
+    }
+
+private:
+    std::size_t _records = 0;
+    std::size_t _fields  = 0;
+};
+
+/**
+ * @brief Parses "--name value" style numeric options
+ *
+ * Returns true and stores the value in %out if argv[i] is %name.
+ */
+inline bool
+parse_option(int argc, char **argv, int &i, const char *name, double &out)
+{
+    if (std::strcmp(argv[i], name) != 0 || i + 1 >= argc)
+        return false;
+
+    out = std::strtod(argv[++i], nullptr);
+    return true;
+}
+} // namespace bench
+
+#endif
@@ -0,0 +1,156 @@
+/**
+ * @file concurrent_bench.cpp
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Measures append throughput under contention
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Usage:
+ *
+ *     dutcpp_concurrent_bench [--ops N] [--max-threads N] [--min-time-ms T]
+ *
+ * 1, 2, 4, ... up to --max-threads (default 64) threads append --ops
+ * elements in total (default 2^22) to one shared container. The containers
+ * are dutcpp::concurrent_vector, with push_back() and with grow_by() in
+ * batches of 64, and a dutcpp::vector behind a std::mutex. ns_per_op is the
+ * wall-clock time per appended element, thread start-up included.
+ */
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "concurrent_vector.h"
+
+namespace
+{
+struct options
+{
+    double ops         = 1 << 22;
+    double max_threads = 64;
+    double min_time_ms = 200;
+};
+
+struct locked_vector
+{
+    std::mutex mutex;
+    dutcpp::vector<std::uint64_t> v;
+
+    void
+    push_back(std::uint64_t x)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        v.push_back(x);
+    }
+};
+
+/**
+ * @brief Runs %body(thread, count) on %threads threads and joins them
+ */
+template <typename Body>
+void
+run_threads(std::size_t threads, std::size_t ops, Body body)
+{
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        const std::size_t count =
+            ops / threads + (t < ops % threads ? 1 : 0);
+        pool.emplace_back(body, t, count);
+    }
+
+    for (auto &th : pool)
+        th.join();
+}
+
+void
+report(bench::json_report &out, const char *container, const char *op,
+       std::size_t threads, std::size_t ops, const bench::result &r)
+{
+    out.begin_record();
+    out.field("container", container);
+    out.field("op", op);
+    out.field("threads", threads);
+    out.field("ops", ops);
+    out.fields(r);
+    out.end_record();
+}
+
+void
+run(bench::json_report &out, const options &opt, std::size_t threads)
+{
+    const std::size_t ops = std::size_t(opt.ops);
+    const double t        = opt.min_time_ms;
+
+    using cvec = std::optional<dutcpp::concurrent_vector<std::uint64_t>>;
+    using lvec = std::optional<locked_vector>;
+
+    report(out, "dutcpp::concurrent_vector", "push_back", threads, ops,
+           bench::measure(ops, t, [] { return cvec(std::in_place); },
+                          [&](cvec &c) {
+                              run_threads(threads, ops,
+                                          [&](std::size_t id, std::size_t n) {
+                                              for (std::size_t i = 0; i < n; ++i)
+                                                  c->push_back(id + i);
+                                          });
+                          }));
+
+    report(out, "dutcpp::concurrent_vector", "grow_by_64", threads, ops,
+           bench::measure(ops, t, [] { return cvec(std::in_place); },
+                          [&](cvec &c) {
+                              run_threads(threads, ops,
+                                          [&](std::size_t id, std::size_t n) {
+                                              for (; n >= 64; n -= 64)
+                                                  c->grow_by(64, id);
+                                              if (n)
+                                                  c->grow_by(n, id);
+                                          });
+                          }));
+
+    report(out, "mutex + dutcpp::vector", "push_back", threads, ops,
+           bench::measure(ops, t, [] { return lvec(std::in_place); },
+                          [&](lvec &c) {
+                              run_threads(threads, ops,
+                                          [&](std::size_t id, std::size_t n) {
+                                              for (std::size_t i = 0; i < n; ++i)
+                                                  c->push_back(id + i);
+                                          });
+                          }));
+}
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+    options opt;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!bench::parse_option(argc, argv, i, "--ops", opt.ops) &&
+            !bench::parse_option(argc, argv, i, "--max-threads",
+                                 opt.max_threads) &&
+            !bench::parse_option(argc, argv, i, "--min-time-ms",
+                                 opt.min_time_ms))
+        {
+            std::fprintf(stderr,
+                         "usage: %s [--ops N] [--max-threads N] "
+                         "[--min-time-ms T]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    bench::json_report out("dutcpp_concurrent_bench");
+
+    for (std::size_t threads = 1; threads <= opt.max_threads; threads *= 2)
+        run(out, opt, threads);
+
+    return 0;
+}
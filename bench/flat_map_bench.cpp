@@ -0,0 +1,160 @@
+/**
+ * @file flat_map_bench.cpp
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Compares flat_map lookups and bulk construction against std::map
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Usage:
+ *
+ *     dutcpp_flat_map_bench [--max-size N] [--lookups N] [--min-time-ms T]
+ *
+ * For N from 2^10 to --max-size (default 2^22) in steps of 4x, each map is
+ * built from N random 32-bit keys ("build", ns per key: one bulk insert for
+ * flat_map, N inserts for std::map), then --lookups (default 2^20) random
+ * keys are looked up ("find", ns per lookup), half of them present. The keys
+ * come from a fixed seed, so every map sees the same work.
+ */
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "flat_map.h"
+
+namespace
+{
+struct options
+{
+    double max_size    = 1 << 22;
+    double lookups     = 1 << 20;
+    double min_time_ms = 50;
+};
+
+using key   = std::uint32_t;
+using value = std::uint32_t;
+
+template <typename Map>
+struct map_name;
+
+template <>
+struct map_name<std::map<key, value>>
+{
+    static constexpr const char *value = "std::map";
+};
+
+template <>
+struct map_name<dutcpp::flat_map<key, value>>
+{
+    static constexpr const char *value = "dutcpp::flat_map<binary_search>";
+};
+
+template <>
+struct map_name<dutcpp::flat_map<key, value, std::less<key>,
+                                 dutcpp::eytzinger_layout>>
+{
+    static constexpr const char *value = "dutcpp::flat_map<eytzinger>";
+};
+
+/**
+ * @brief Returns %n random pairs, and %lookups keys of which every other one
+ * is taken from the pairs
+ */
+void
+make_keys(std::size_t n, std::size_t lookups,
+          std::vector<std::pair<key, value>> &pairs, std::vector<key> &probes)
+{
+    std::mt19937 rng(42);
+
+    pairs.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+        pairs[i] = {key(rng()), value(i)};
+
+    probes.resize(lookups);
+    for (std::size_t i = 0; i < lookups; ++i)
+        probes[i] = (i % 2) ? key(rng()) : pairs[rng() % n].first;
+}
+
+template <typename Map>
+void
+run_size(bench::json_report &out, const options &opt, std::size_t n)
+{
+    std::vector<std::pair<key, value>> pairs;
+    std::vector<key> probes;
+    make_keys(n, std::size_t(opt.lookups), pairs, probes);
+
+    const bench::result build = bench::measure(
+        n, opt.min_time_ms, [] { return std::optional<Map>(std::in_place); },
+        [&](std::optional<Map> &m) {
+            m->insert(pairs.begin(), pairs.end());
+            bench::do_not_optimize(m->size());
+        });
+
+    out.begin_record();
+    out.field("container", map_name<Map>::value);
+    out.field("op", "build");
+    out.field("size", n);
+    out.fields(build);
+    out.end_record();
+
+    const Map m(pairs.begin(), pairs.end());
+
+    const bench::result find = bench::measure(
+        probes.size(), opt.min_time_ms, [] { return 0; },
+        [&](int &) {
+            std::size_t found = 0;
+
+            for (key k : probes)
+                found += (m.find(k) != m.end());
+
+            bench::do_not_optimize(found);
+        });
+
+    out.begin_record();
+    out.field("container", map_name<Map>::value);
+    out.field("op", "find");
+    out.field("size", n);
+    out.fields(find);
+    out.end_record();
+}
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+    options opt;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!bench::parse_option(argc, argv, i, "--max-size", opt.max_size) &&
+            !bench::parse_option(argc, argv, i, "--lookups", opt.lookups) &&
+            !bench::parse_option(argc, argv, i, "--min-time-ms",
+                                 opt.min_time_ms))
+        {
+            std::fprintf(stderr,
+                         "usage: %s [--max-size N] [--lookups N] "
+                         "[--min-time-ms T]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    bench::json_report out("dutcpp_flat_map_bench");
+
+    for (double n = 1 << 10; n <= opt.max_size; n *= 4)
+    {
+        const std::size_t size = std::size_t(n);
+
+        run_size<std::map<key, value>>(out, opt, size);
+        run_size<dutcpp::flat_map<key, value>>(out, opt, size);
+        run_size<dutcpp::flat_map<key, value, std::less<key>,
+                                  dutcpp::eytzinger_layout>>(out, opt, size);
+    }
+
+    return 0;
+}
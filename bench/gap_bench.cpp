@@ -0,0 +1,151 @@
+/**
+ * @file gap_bench.cpp
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Compares gap_vector against vector::insert for clustered edits
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Usage:
+ *
+ *     dutcpp_gap_bench [--max-size N] [--edits N] [--min-time-ms T]
+ *
+ * Each repetition starts from a container of N ints, N from 2^10 to
+ * --max-size (default 2^20) in steps of 16x, and inserts --edits elements
+ * (default 2^12) in clusters: a cursor jumps to a random position, then
+ * %run consecutive elements are inserted there, like typing in an editor.
+ * Cluster lengths are 1, 16 and 256. ns_per_op is the time per inserted
+ * element. The jump positions come from a fixed seed, so both containers see
+ * the same edits.
+ */
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "gap_vector.h"
+#include "vector.h"
+
+namespace
+{
+struct options
+{
+    double max_size    = 1 << 20;
+    double edits       = 1 << 12;
+    double min_time_ms = 50;
+};
+
+template <typename Container>
+struct container_name;
+
+template <>
+struct container_name<dutcpp::vector<int>>
+{
+    static constexpr const char *value = "dutcpp::vector";
+};
+
+template <>
+struct container_name<dutcpp::gap_vector<int>>
+{
+    static constexpr const char *value = "dutcpp::gap_vector";
+};
+
+/**
+ * @brief Returns the cursor position of each cluster
+ *
+ * Positions are drawn as fractions of the current size, so they stay valid
+ * while the container grows.
+ */
+std::vector<double>
+cluster_positions(std::size_t clusters)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    std::vector<double> positions(clusters);
+    for (auto &p : positions)
+        p = dist(rng);
+
+    return positions;
+}
+
+template <typename Container>
+void
+run_size(bench::json_report &out, const options &opt, std::size_t n,
+         std::size_t run)
+{
+    using slot = std::optional<Container>;
+
+    const std::size_t edits    = std::size_t(opt.edits);
+    const std::size_t clusters = (edits + run - 1) / run;
+    const auto positions       = cluster_positions(clusters);
+
+    const bench::result r = bench::measure(
+        edits, opt.min_time_ms,
+        [&] {
+            slot s(std::in_place);
+            s->reserve(n + edits);
+            for (std::size_t i = 0; i < n; ++i)
+                s->push_back(int(i));
+            return s;
+        },
+        [&](slot &s) {
+            std::size_t done = 0;
+
+            for (std::size_t c = 0; c < clusters; ++c)
+            {
+                std::size_t pos = std::size_t(positions[c] * s->size());
+
+                for (std::size_t k = 0; k < run && done < edits; ++k, ++done)
+                    s->insert(s->begin() + pos++, int(done));
+            }
+
+            bench::do_not_optimize(s->size());
+        });
+
+    out.begin_record();
+    out.field("container", container_name<Container>::value);
+    out.field("op", "clustered_insert");
+    out.field("size", n);
+    out.field("run", run);
+    out.fields(r);
+    out.end_record();
+}
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+    options opt;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!bench::parse_option(argc, argv, i, "--max-size", opt.max_size) &&
+            !bench::parse_option(argc, argv, i, "--edits", opt.edits) &&
+            !bench::parse_option(argc, argv, i, "--min-time-ms",
+                                 opt.min_time_ms))
+        {
+            std::fprintf(stderr,
+                         "usage: %s [--max-size N] [--edits N] "
+                         "[--min-time-ms T]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    bench::json_report out("dutcpp_gap_bench");
+
+    for (double n = 1 << 10; n <= opt.max_size; n *= 16)
+    {
+        for (std::size_t run : {1, 16, 256})
+        {
+            run_size<dutcpp::vector<int>>(out, opt, std::size_t(n), run);
+            run_size<dutcpp::gap_vector<int>>(out, opt, std::size_t(n), run);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file tail_latency_bench.cpp
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Measures the worst single push_back of vector and incremental_vector
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Usage:
+ *
+ *     dutcpp_tail_latency_bench [--size N] [--reps N]
+ *
+ * Each repetition appends --size elements (default 2^24) one at a time to an
+ * empty container and times every push_back on its own. The records give
+ * the mean, the 50th, 99th and 99.9th percentiles and the maximum over all
+ * repetitions (default 3), in nanoseconds, clock overhead included. The
+ * maximum is where vector pays for moving the whole buffer.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "incremental_vector.h"
+#include "vector.h"
+
+namespace
+{
+struct options
+{
+    double size = 1 << 24;
+    double reps = 3;
+};
+
+template <typename Container>
+struct container_name;
+
+template <typename Tp>
+struct container_name<std::vector<Tp>>
+{
+    static constexpr const char *value = "std::vector";
+};
+
+template <typename Tp>
+struct container_name<dutcpp::vector<Tp>>
+{
+    static constexpr const char *value = "dutcpp::vector";
+};
+
+template <typename Tp>
+struct container_name<dutcpp::incremental_vector<Tp>>
+{
+    static constexpr const char *value = "dutcpp::incremental_vector";
+};
+
+template <typename Tp>
+struct element;
+
+template <>
+struct element<int>
+{
+    static constexpr const char *name = "int";
+
+    static int
+    make(std::size_t i)
+    {
+        return int(i);
+    }
+};
+
+template <>
+struct element<std::string>
+{
+    static constexpr const char *name = "std::string";
+
+    static std::string
+    make(std::size_t i)
+    {
+        return std::to_string(i);
+    }
+};
+
+template <typename Container>
+void
+run(bench::json_report &out, const options &opt)
+{
+    using clock = std::chrono::steady_clock;
+    using value = typename Container::value_type;
+
+    const std::size_t n    = std::size_t(opt.size);
+    const std::size_t reps = std::max<std::size_t>(std::size_t(opt.reps), 1);
+
+    std::vector<std::uint64_t> ns;
+    ns.reserve(n * reps);
+
+    for (std::size_t r = 0; r < reps; ++r)
+    {
+        Container c;
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            value x = element<value>::make(i);
+
+            const auto t0 = clock::now();
+            c.push_back(std::move(x));
+            const auto t1 = clock::now();
+
+            ns.push_back(std::chrono::nanoseconds(t1 - t0).count());
+        }
+
+        bench::do_not_optimize(c.back());
+    }
+
+    double total = 0;
+    for (std::uint64_t t : ns)
+        total += double(t);
+
+    auto percentile = [&](double q) {
+        auto it = ns.begin() + std::size_t(q * double(ns.size() - 1));
+        std::nth_element(ns.begin(), it, ns.end());
+        return std::size_t(*it);
+    };
+
+    out.begin_record();
+    out.field("container", container_name<Container>::value);
+    out.field("element", element<value>::name);
+    out.field("size", n);
+    out.field("mean_ns", total / double(ns.size()));
+    out.field("p50_ns", percentile(0.5));
+    out.field("p99_ns", percentile(0.99));
+    out.field("p999_ns", percentile(0.999));
+    out.field("max_ns", percentile(1.0));
+    out.field("reps", reps);
+    out.end_record();
+}
+
+template <typename Tp>
+void
+run_element(bench::json_report &out, const options &opt)
+{
+    run<std::vector<Tp>>(out, opt);
+    run<dutcpp::vector<Tp>>(out, opt);
+    run<dutcpp::incremental_vector<Tp>>(out, opt);
+}
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+    options opt;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!bench::parse_option(argc, argv, i, "--size", opt.size) &&
+            !bench::parse_option(argc, argv, i, "--reps", opt.reps))
+        {
+            std::fprintf(stderr, "usage: %s [--size N] [--reps N]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    bench::json_report out("dutcpp_tail_latency_bench");
+
+    run_element<int>(out, opt);
+    run_element<std::string>(out, opt);
+
+    return 0;
+}
@@ -0,0 +1,340 @@
+/**
+ * @file vector_bench.cpp
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Compares dutcpp::vector against std::vector
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Usage:
+ *
+ *     dutcpp_bench [--max-size N] [--max-insert-size N] [--min-time-ms T]
+ *
+ * Sizes go from 8 to 10^8 in steps of 8x, up to --max-size (default 2^21).
+ * Front and middle insertion are quadratic, so they stop at
+ * --max-insert-size (default 2^14). Results are printed as JSON, with ns_per_op
+ * measured per element (per vector for move_construct) and allocation counts
+ * per repetition.
+ *
+ * Allocations are counted by replacing operator new (see bench.h). Buffers of
+ * mmap_threshold bytes or more (32 MiB by default) for trivially relocatable
+ * elements are mapped directly by dutcpp::vector, so they do not show up in
+ * the counts of the dutcpp rows.
+ */
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "vector.h"
+
+namespace
+{
+struct options
+{
+    double max_size        = 1 << 21;
+    double max_insert_size = 1 << 14;
+    double min_time_ms     = 50;
+};
+
+struct pod64
+{
+    std::uint64_t v[8];
+};
+
+struct move_only
+{
+    std::uint64_t v;
+
+    explicit move_only(std::uint64_t x) noexcept : v(x) { }
+
+    move_only(move_only &&) noexcept            = default;
+    move_only &operator=(move_only &&) noexcept = default;
+
+    move_only(const move_only &)            = delete;
+    move_only &operator=(const move_only &) = delete;
+};
+
+template <typename Tp>
+struct element;
+
+template <>
+struct element<int>
+{
+    static constexpr const char *name = "int";
+
+    static int
+    make(std::size_t i)
+    {
+        return int(i);
+    }
+
+    static std::uint64_t
+    touch(const int &x)
+    {
+        return std::uint64_t(x);
+    }
+};
+
+template <>
+struct element<pod64>
+{
+    static constexpr const char *name = "pod64";
+
+    static pod64
+    make(std::size_t i)
+    {
+        return pod64{{i, i, i, i, i, i, i, i}};
+    }
+
+    static std::uint64_t
+    touch(const pod64 &x)
+    {
+        return x.v[0];
+    }
+};
+
+template <>
+struct element<std::string>
+{
+    static constexpr const char *name = "std::string";
+
+    // Long enough to defeat the small string optimization
+    static std::string
+    make(std::size_t i)
+    {
+        return std::string(32, char('a' + i % 26));
+    }
+
+    static std::uint64_t
+    touch(const std::string &x)
+    {
+        return x.size();
+    }
+};
+
+template <>
+struct element<move_only>
+{
+    static constexpr const char *name = "move_only";
+
+    static move_only
+    make(std::size_t i)
+    {
+        return move_only(i);
+    }
+
+    static std::uint64_t
+    touch(const move_only &x)
+    {
+        return x.v;
+    }
+};
+
+template <typename Container>
+struct container_name;
+
+template <typename Tp>
+struct container_name<std::vector<Tp>>
+{
+    static constexpr const char *value = "std::vector";
+};
+
+template <typename Tp>
+struct container_name<dutcpp::vector<Tp>>
+{
+    static constexpr const char *value = "dutcpp::vector";
+};
+
+template <typename Container>
+Container
+build(std::size_t n)
+{
+    using Tp = typename Container::value_type;
+
+    Container c;
+    for (std::size_t i = 0; i < n; ++i)
+        c.push_back(element<Tp>::make(i));
+
+    return c;
+}
+
+template <typename Container>
+void
+report(bench::json_report &out, const char *op, std::size_t n,
+       const bench::result &r)
+{
+    using Tp = typename Container::value_type;
+
+    out.begin_record();
+    out.field("container", container_name<Container>::value);
+    out.field("type", element<Tp>::name);
+    out.field("op", op);
+    out.field("size", n);
+    out.fields(r);
+    out.end_record();
+}
+
+template <typename Container>
+void
+run_size(bench::json_report &out, const options &opt, std::size_t n)
+{
+    using Tp   = typename Container::value_type;
+    using slot = std::optional<Container>;
+
+    constexpr bool copyable = std::is_copy_constructible<Tp>::value;
+    const double t          = opt.min_time_ms;
+    auto empty              = [] { return slot(); };
+
+    if constexpr (copyable)
+    {
+        const Tp value = element<Tp>::make(1);
+        const std::vector<Tp> src(n, value);
+        const Container prebuilt = build<Container>(n);
+
+        report<Container>(out, "fill_construct", n,
+                          bench::measure(n, t, empty,
+                                         [&](slot &s) { s.emplace(n, value); }));
+
+        if constexpr (std::is_same<Container, dutcpp::vector<Tp>>::value)
+        {
+            report<Container>(out, "par_fill_construct", n,
+                              bench::measure(n, t, empty, [&](slot &s) {
+                                  s.emplace(dutcpp::par, n, value);
+                              }));
+        }
+
+        report<Container>(
+            out, "range_construct", n,
+            bench::measure(n, t, empty, [&](slot &s) {
+                s.emplace(src.begin(), src.end());
+            }));
+
+        report<Container>(out, "copy_construct", n,
+                          bench::measure(n, t, empty,
+                                         [&](slot &s) { s.emplace(prebuilt); }));
+
+        if (n == 8)
+        {
+            report<Container>(
+                out, "init_list_construct", n,
+                bench::measure(n, t, empty, [&](slot &s) {
+                    s.emplace(std::initializer_list<Tp>{
+                        value, value, value, value, value, value, value,
+                        value});
+                }));
+        }
+
+        if (n <= opt.max_insert_size)
+        {
+            report<Container>(out, "front_insert", n,
+                              bench::measure(n, t, empty, [&](slot &s) {
+                                  s.emplace();
+                                  for (std::size_t i = 0; i < n; ++i)
+                                      s->insert(s->begin(), value);
+                              }));
+
+            report<Container>(out, "middle_insert", n,
+                              bench::measure(n, t, empty, [&](slot &s) {
+                                  s.emplace();
+                                  for (std::size_t i = 0; i < n; ++i)
+                                      s->insert(s->begin() + s->size() / 2,
+                                                value);
+                              }));
+        }
+    }
+
+    // The moved-from vector is destroyed outside of the timed region.
+    struct move_state
+    {
+        slot src;
+        slot dst;
+    };
+
+    report<Container>(out, "move_construct", n,
+                      bench::measure(
+                          1, t,
+                          [&] {
+                              return move_state{build<Container>(n), slot()};
+                          },
+                          [](move_state &s) { s.dst.emplace(std::move(*s.src)); }));
+
+    report<Container>(out, "back_insert", n,
+                      bench::measure(n, t, empty, [&](slot &s) {
+                          s.emplace();
+                          for (std::size_t i = 0; i < n; ++i)
+                              s->push_back(element<Tp>::make(i));
+                      }));
+
+    {
+        const Container c = build<Container>(n);
+
+        report<Container>(out, "iterate", n,
+                          bench::measure(n, t, [] { return 0; },
+                                         [&](int &) {
+                                             std::uint64_t sum = 0;
+                                             for (const auto &x : c)
+                                                 sum += element<Tp>::touch(x);
+                                             bench::do_not_optimize(sum);
+                                         }));
+    }
+
+    report<Container>(out, "destroy", n,
+                      bench::measure(
+                          n, t, [&] { return slot(build<Container>(n)); },
+                          [](slot &s) { s.reset(); }));
+}
+
+template <typename Tp>
+void
+run_type(bench::json_report &out, const options &opt)
+{
+    for (double n = 8; n <= opt.max_size && n <= 1e8; n *= 8)
+    {
+        run_size<std::vector<Tp>>(out, opt, std::size_t(n));
+        run_size<dutcpp::vector<Tp>>(out, opt, std::size_t(n));
+    }
+
+    if (opt.max_size >= 1e8)
+    {
+        run_size<std::vector<Tp>>(out, opt, 100000000);
+        run_size<dutcpp::vector<Tp>>(out, opt, 100000000);
+    }
+}
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+    options opt;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!bench::parse_option(argc, argv, i, "--max-size", opt.max_size) &&
+            !bench::parse_option(argc, argv, i, "--max-insert-size",
+                                 opt.max_insert_size) &&
+            !bench::parse_option(argc, argv, i, "--min-time-ms",
+                                 opt.min_time_ms))
+        {
+            std::fprintf(stderr,
+                         "usage: %s [--max-size N] [--max-insert-size N] "
+                         "[--min-time-ms T]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    bench::json_report out("dutcpp_bench");
+
+    run_type<int>(out, opt);
+    run_type<pod64>(out, opt);
+    run_type<std::string>(out, opt);
+    run_type<move_only>(out, opt);
+
+    return 0;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file arena.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A monotonic arena and an allocator that draws from it
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef __DUTCPP_ARENA_H
+#define __DUTCPP_ARENA_H 1
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+namespace dutcpp
+{
+/**
+ * @brief A monotonic bump allocator
+ *
+ * Memory is handed out by bumping a pointer through large chunks obtained
+ * from the global heap. Individual deallocations are no-ops (except for the
+ * most recent block, which is given back to the arena), and everything is
+ * freed at once by release() or by the destructor.
+ *
+ * An arena is not thread-safe. The intended use is one arena per request,
+ * shared by all the short-lived containers of that request.
+ */
+class arena
+{
+public:
+    /**
+     * @brief Constructs an arena whose first chunk holds %chunk_size bytes
+     *
+     * No memory is allocated until the first call to allocate(). Each new
+     * chunk is twice as large as the previous one.
+     */
+    explicit arena(std::size_t chunk_size = 4096) noexcept
+    : _initial(nullptr), _initial_size(0), _chunks(nullptr),
+      _chunk_size(chunk_size), _next_chunk_size(chunk_size)
+    {
+        _reset();
+    }
+
+    /**
+     * @brief Constructs an arena that serves from %buffer first
+     *
+     * The arena does not own %buffer, which must outlive it. Once %buffer is
+     * used up, chunks are taken from the global heap.
+     */
+    arena(void *buffer, std::size_t size,
+          std::size_t chunk_size = 4096) noexcept
+    : _initial(static_cast<char *>(buffer)), _initial_size(size),
+      _chunks(nullptr), _chunk_size(chunk_size), _next_chunk_size(chunk_size)
+    {
+        _reset();
+    }
+
+    arena(const arena &)            = delete;
+    arena &operator=(const arena &) = delete;
+
+    ~arena()
+    {
+        release();
+    }
+
+    /**
+     * @brief Returns %bytes of storage aligned to %align
+     */
+    void *
+    allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t))
+    {
+        if (bytes == 0)
+            bytes = 1;
+
+        char *p = _align_up(_cur, align);
+
+        if (p < _cur || p > _limit || std::size_t(_limit - p) < bytes)
+        {
+            _grow(bytes + align);
+            p = _align_up(_cur, align);
+        }
+
+        _cur = p + bytes;
+
+        return p;
+    }
+
+    /**
+     * @brief Gives back %bytes of storage at %p
+     *
+     * Only the most recent allocation is actually reclaimed. Any other block
+     * stays in use until release().
+     */
+    void
+    deallocate(void *p, std::size_t bytes) noexcept
+    {
+        if (static_cast<char *>(p) + (bytes ? bytes : 1) == _cur)
+            _cur = static_cast<char *>(p);
+    }
+
+    /**
+     * @brief Frees every chunk at once
+     *
+     * All memory handed out by this arena becomes invalid. The arena can be
+     * used again afterwards.
+     */
+    void
+    release() noexcept
+    {
+        while (_chunks)
+        {
+            _chunk *next = _chunks->next;
+            ::operator delete(static_cast<void *>(_chunks));
+            _chunks = next;
+        }
+
+        _next_chunk_size = _chunk_size;
+        _reset();
+    }
+
+private:
+    struct alignas(std::max_align_t) _chunk
+    {
+        _chunk *next;
+    };
+
+    char *_initial;
+    std::size_t _initial_size;
+    _chunk *_chunks;
+    std::size_t _chunk_size;
+    std::size_t _next_chunk_size;
+    char *_cur;
+    char *_limit;
+
+    static char *
+    _align_up(char *p, std::size_t align) noexcept
+    {
+        const std::uintptr_t n = reinterpret_cast<std::uintptr_t>(p);
+
+        return reinterpret_cast<char *>((n + align - 1) & ~(align - 1));
+    }
+
+    void
+    _reset() noexcept
+    {
+        _cur   = _initial;
+        _limit = _initial + _initial_size;
+    }
+
+    void
+    _grow(std::size_t min_bytes)
+    {
+        std::size_t size = _next_chunk_size;
+
+        if (size < min_bytes)
+            size = min_bytes;
+
+        if (size > std::numeric_limits<std::size_t>::max() - sizeof(_chunk))
+            throw std::bad_alloc();
+
+        void *raw = ::operator new(sizeof(_chunk) + size);
+
+        _chunks = ::new (raw) _chunk{_chunks};
+        _cur    = reinterpret_cast<char *>(_chunks + 1);
+        _limit  = _cur + size;
+
+        if (_next_chunk_size <= std::numeric_limits<std::size_t>::max() / 2)
+            _next_chunk_size *= 2;
+    }
+};
+
+/**
+ * @brief An allocator that draws from a dutcpp::arena
+ *
+ * Copies share the same arena, and two allocators are equal if they use the
+ * same arena. Like std::pmr::polymorphic_allocator, it does not propagate on
+ * container copy, move or swap, so a container always allocates from the
+ * arena it was constructed with.
+ */
+template <typename Tp>
+class arena_allocator
+{
+public:
+    using value_type = Tp;
+
+    arena_allocator(arena &a) noexcept : _arena(&a) { }
+
+    template <typename Up>
+    arena_allocator(const arena_allocator<Up> &other) noexcept
+    : _arena(other.resource())
+    {
+    }
+
+    Tp *
+    allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(Tp))
+            throw std::bad_array_new_length();
+
+        return static_cast<Tp *>(_arena->allocate(n * sizeof(Tp), alignof(Tp)));
+    }
+
+    void
+    deallocate(Tp *p, std::size_t n) noexcept
+    {
+        _arena->deallocate(p, n * sizeof(Tp));
+    }
+
+    /**
+     * @brief Returns the arena this allocator draws from
+     */
+    arena *
+    resource() const noexcept
+    {
+        return _arena;
+    }
+
+private:
+    arena *_arena;
+};
+
+template <typename Tp, typename Up>
+inline bool
+operator==(const arena_allocator<Tp> &lhs,
+           const arena_allocator<Up> &rhs) noexcept
+{
+    return lhs.resource() == rhs.resource();
+}
+
+template <typename Tp, typename Up>
+inline bool
+operator!=(const arena_allocator<Tp> &lhs,
+           const arena_allocator<Up> &rhs) noexcept
+{
+    return lhs.resource() != rhs.resource();
+}
+} // namespace dutcpp
+
+#endif
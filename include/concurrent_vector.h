@@ -0,0 +1,583 @@
+/**
+ * @file concurrent_vector.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief An append-only vector that many threads can grow at once
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef __DUTCPP_CONCURRENT_VECTOR_H
+#define __DUTCPP_CONCURRENT_VECTOR_H 1
+
+#include <atomic>
+#include <bit>
+
+#include "vector.h"
+
+namespace dutcpp
+{
+/**
+ * @brief An append-only vector with stable references
+ *
+ * Elements live in segments whose sizes are powers of two: segment 0 holds
+ * the first 8 elements, and segment k holds the next 8 * 2^k. A segment never
+ * moves once allocated, so growing the vector does not invalidate references,
+ * pointers or iterators.
+ *
+ *     segment 0      segment 1               segment 2
+ *     [0 ..... 7]    [8 ............ 23]     [24 ...................... 55]
+ *
+ * push_back(), emplace_back(), grow_by() and reserve() may be called from any
+ * number of threads at the same time, and alongside them element access,
+ * size() and iteration. They are lock-free: a thread claims its range with a
+ * compare-and-swap on the size, once every segment the range needs has been
+ * allocated. Element access is wait-free: it computes the segment with a bit
+ * scan and loads one pointer.
+ *
+ * size() counts the elements claimed so far, some of which may still be under
+ * construction by other threads. An element is safe to read once the call
+ * that appended it has returned and the reader has synchronized with that
+ * thread (e.g. by receiving the returned iterator through a queue).
+ *
+ * push_back(), emplace_back(), grow_by() and reserve() call Alloc::allocate()
+ * and Alloc::deallocate() from whichever threads append, possibly at the same
+ * time, so %Alloc must be safe to use from several threads at once.
+ * std::allocator is; a std::pmr::polymorphic_allocator is only if its memory
+ * resource is (e.g. std::pmr::synchronized_pool_resource).
+ *
+ * clear(), swap() and move assignment are not thread-safe.
+ */
+template <typename Tp, typename Alloc = std::allocator<Tp>>
+class concurrent_vector
+{
+public:
+    using value_type      = Tp;
+    using reference       = Tp &;
+    using const_reference = const Tp &;
+    using pointer         = Tp *;
+    using const_pointer   = const Tp *;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using allocator_type = Alloc;
+    using traits_t       = std::allocator_traits<allocator_type>;
+
+    using iterator               = __indexed_iterator<concurrent_vector, false>;
+    using const_iterator         = __indexed_iterator<concurrent_vector, true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static_assert(std::is_nothrow_move_constructible<Tp>::value,
+                  "concurrent_vector requires a nothrow move constructor");
+
+    concurrent_vector() noexcept(noexcept(allocator_type()))
+    : concurrent_vector(allocator_type())
+    {
+    }
+
+    explicit concurrent_vector(const allocator_type &alloc) noexcept
+    : _alloc(alloc), _size(0)
+    {
+        for (auto &segment : _segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+    }
+
+    concurrent_vector(const concurrent_vector &)            = delete;
+    concurrent_vector &operator=(const concurrent_vector &) = delete;
+
+    concurrent_vector(concurrent_vector &&other) noexcept
+    : concurrent_vector(other._alloc)
+    {
+        _steal(other);
+    }
+
+    /**
+     * @brief Move assignment, not thread-safe
+     *
+     * The segments of %other are taken over if
+     * propagate_on_container_move_assignment is true or both allocators are
+     * equal. Otherwise, the elements are moved one by one into segments from
+     * the current allocator.
+     */
+    concurrent_vector &
+    operator=(concurrent_vector &&other) noexcept(
+        traits_t::propagate_on_container_move_assignment::value ||
+        traits_t::is_always_equal::value)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_move_assignment::value)
+        {
+            _release();
+            _alloc = std::move(other._alloc);
+            _steal(other);
+        }
+        else if (traits_t::is_always_equal::value || _alloc == other._alloc)
+        {
+            _release();
+            _steal(other);
+        }
+        else
+        {
+            const size_type n = other._size.load(std::memory_order_relaxed);
+
+            clear();
+            reserve(n);
+
+            for (size_type i = 0; i < n; ++i)
+                _append_one(std::move(other[i]));
+
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    ~concurrent_vector()
+    {
+        _release();
+    }
+
+    /**
+     * @brief Swaps the contents with %other, not thread-safe
+     *
+     * Allocators are swapped only if propagate_on_container_swap is true.
+     * Otherwise, they must compare equal.
+     */
+    void
+    swap(concurrent_vector &other) noexcept
+    {
+        if constexpr (traits_t::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(_alloc, other._alloc);
+        }
+
+        for (size_type k = 0; k < _max_segments; ++k)
+        {
+            pointer p = _segments[k].load(std::memory_order_relaxed);
+            _segments[k].store(
+                other._segments[k].load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+            other._segments[k].store(p, std::memory_order_relaxed);
+        }
+
+        const size_type n = _size.load(std::memory_order_relaxed);
+        _size.store(other._size.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+        other._size.store(n, std::memory_order_relaxed);
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _alloc;
+    }
+
+    /**
+     * @brief Appends a copy of %value and returns an iterator to it
+     *
+     * The copy is made before a slot is claimed, so if it throws, nothing
+     * changes.
+     */
+    iterator
+    push_back(const value_type &value)
+    {
+        return iterator(this, _append_one(value_type(value)));
+    }
+
+    iterator
+    push_back(value_type &&value)
+    {
+        return iterator(this, _append_one(std::move(value)));
+    }
+
+    template <typename... Args>
+    reference
+    emplace_back(Args &&...args)
+    {
+        return (*this)[_append_one(value_type(std::forward<Args>(args)...))];
+    }
+
+    /**
+     * @brief Appends %n value-initialized elements
+     *
+     * Returns an iterator to the first of them. The new elements are
+     * contiguous in index, though not necessarily in memory.
+     */
+    iterator
+    grow_by(size_type n)
+    {
+        static_assert(std::is_nothrow_default_constructible<Tp>::value,
+                      "grow_by(n) requires a nothrow default constructor");
+
+        const size_type first = _claim(n);
+
+        for (size_type i = first; i < first + n; ++i)
+            traits_t::construct(_alloc, _slot(i));
+
+        return iterator(this, first);
+    }
+
+    /**
+     * @brief Appends %n copies of %value
+     *
+     * The slots are claimed before the copies are made. If a copy throws,
+     * the remaining slots are value-initialized and the exception is
+     * rethrown, so every claimed slot holds an element.
+     */
+    iterator
+    grow_by(size_type n, const value_type &value)
+    {
+        static_assert(std::is_nothrow_default_constructible<Tp>::value,
+                      "grow_by(n, value) requires a nothrow default "
+                      "constructor");
+
+        const value_type tmp  = value; // %value may live in a segment
+        const size_type first = _claim(n);
+        size_type i           = first;
+
+        try
+        {
+            for (; i < first + n; ++i)
+                traits_t::construct(_alloc, _slot(i), tmp);
+        }
+        catch (...)
+        {
+            for (; i < first + n; ++i)
+                traits_t::construct(_alloc, _slot(i));
+            throw;
+        }
+
+        return iterator(this, first);
+    }
+
+    /**
+     * @brief Allocates the segments needed to hold %n elements
+     */
+    void
+    reserve(size_type n)
+    {
+        if (n > max_size())
+            std::__throw_length_error("concurrent_vector::reserve");
+
+        if (n > 0)
+            _ensure_segments(0, n);
+    }
+
+    /**
+     * @brief Destroys all elements, keeping the segments; not thread-safe
+     */
+    void
+    clear() noexcept
+    {
+        const size_type n = _size.load(std::memory_order_relaxed);
+
+        for (size_type i = 0; i < n; ++i)
+            traits_t::destroy(_alloc, _slot(i));
+
+        _size.store(0, std::memory_order_relaxed);
+    }
+
+    reference
+    operator[](size_type pos) noexcept
+    {
+        return *_slot(pos);
+    }
+
+    const_reference
+    operator[](size_type pos) const noexcept
+    {
+        return *_slot(pos);
+    }
+
+    /**
+     * @brief Returns a reference to the element at %pos
+     *
+     * Throws std::out_of_range if %pos >= size().
+     */
+    reference
+    at(size_type pos)
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("concurrent_vector::at");
+
+        return *_slot(pos);
+    }
+
+    const_reference
+    at(size_type pos) const
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("concurrent_vector::at");
+
+        return *_slot(pos);
+    }
+
+    reference
+    front() noexcept
+    {
+        return *_slot(0);
+    }
+
+    const_reference
+    front() const noexcept
+    {
+        return *_slot(0);
+    }
+
+    reference
+    back() noexcept
+    {
+        return *_slot(size() - 1);
+    }
+
+    const_reference
+    back() const noexcept
+    {
+        return *_slot(size() - 1);
+    }
+
+    iterator
+    begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    /**
+     * @brief Returns an iterator to one-past the elements claimed so far
+     */
+    iterator
+    end() noexcept
+    {
+        return iterator(this, size());
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(this, size());
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return const_iterator(this, size());
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _size.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns the number of elements the allocated segments can hold
+     * before the next segment is needed
+     */
+    size_type
+    capacity() const noexcept
+    {
+        size_type k = 0;
+        while (k < _max_segments &&
+               _segments[k].load(std::memory_order_acquire))
+            ++k;
+
+        return _segment_first(k);
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return std::min<size_type>(traits_t::max_size(_alloc),
+                                   _segment_first(_max_segments));
+    }
+
+private:
+    // Segment k holds the indices [8 * (2^k - 1), 8 * (2^(k+1) - 1)).
+    static constexpr size_type _first_log    = 3;
+    static constexpr size_type _max_segments = 64 - _first_log - 1;
+
+    static constexpr size_type
+    _segment_size(size_type k) noexcept
+    {
+        return size_type(1) << (k + _first_log);
+    }
+
+    static constexpr size_type
+    _segment_first(size_type k) noexcept
+    {
+        return (size_type(1) << (k + _first_log)) - (size_type(1) << _first_log);
+    }
+
+    static size_type
+    _segment_of(size_type i) noexcept
+    {
+        return std::bit_width((i >> _first_log) + 1) - 1;
+    }
+
+    pointer
+    _slot(size_type i) const noexcept
+    {
+        const size_type k = _segment_of(i);
+        return _segments[k].load(std::memory_order_acquire) +
+               (i - _segment_first(k));
+    }
+
+    /**
+     * @brief Makes sure the segments covering [first, last) are allocated
+     *
+     * When two threads race for the same segment, the loser gives its
+     * allocation back and uses the winner's.
+     */
+    void
+    _ensure_segments(size_type first, size_type last)
+    {
+        const size_type k_last = _segment_of(last - 1);
+
+        for (size_type k = _segment_of(first); k <= k_last; ++k)
+        {
+            if (_segments[k].load(std::memory_order_acquire))
+                continue;
+
+            pointer p        = traits_t::allocate(_alloc, _segment_size(k));
+            pointer expected = nullptr;
+
+            if (!_segments[k].compare_exchange_strong(
+                    expected, p, std::memory_order_acq_rel,
+                    std::memory_order_acquire))
+                traits_t::deallocate(_alloc, p, _segment_size(k));
+        }
+    }
+
+    /**
+     * @brief Claims %n consecutive indices and returns the first one
+     *
+     * Segments are allocated before the claim is published, so a failed
+     * allocation leaves nothing half done.
+     */
+    size_type
+    _claim(size_type n)
+    {
+        size_type first = _size.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            if (max_size() - first < n)
+                std::__throw_length_error("concurrent_vector");
+
+            if (n > 0)
+                _ensure_segments(first, first + n);
+
+            if (_size.compare_exchange_weak(first, first + n,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_relaxed))
+                return first;
+        }
+    }
+
+    /**
+     * @brief Destroys every element and frees every segment
+     */
+    void
+    _release() noexcept
+    {
+        clear();
+
+        for (size_type k = 0; k < _max_segments; ++k)
+        {
+            pointer p = _segments[k].load(std::memory_order_relaxed);
+            if (p)
+                traits_t::deallocate(_alloc, p, _segment_size(k));
+
+            _segments[k].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Takes over the segments of %other, leaving it empty
+     *
+     * Expects this concurrent_vector to have no segments.
+     */
+    void
+    _steal(concurrent_vector &other) noexcept
+    {
+        for (size_type k = 0; k < _max_segments; ++k)
+            _segments[k].store(
+                other._segments[k].exchange(nullptr,
+                                            std::memory_order_relaxed),
+                std::memory_order_relaxed);
+
+        _size.store(other._size.exchange(0, std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+    }
+
+    size_type
+    _append_one(value_type &&value)
+    {
+        const size_type i = _claim(1);
+        traits_t::construct(_alloc, _slot(i), std::move(value));
+
+        return i;
+    }
+
+    allocator_type _alloc;
+    std::atomic<pointer> _segments[_max_segments];
+    std::atomic<size_type> _size;
+};
+
+template <typename Tp, typename Alloc>
+inline void
+swap(concurrent_vector<Tp, Alloc> &lhs,
+     concurrent_vector<Tp, Alloc> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+} // namespace dutcpp
+
+#endif
@@ -0,0 +1,1044 @@
+/**
+ * @file devector.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A contiguous vector with spare capacity at both ends
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef __DUTCPP_DEVECTOR_H
+#define __DUTCPP_DEVECTOR_H 1
+
+#include "vector.h"
+
+namespace dutcpp
+{
+/**
+ * @brief A double-ended vector
+ *
+ * Like vector, the elements are contiguous and data() can be handed to C
+ * APIs, but the buffer keeps spare room in front of the elements as well as
+ * behind them:
+ *
+ *     _buf        _start                  _finish       _end
+ *      |            |                        |            |
+ *      v            v                        v            v
+ *      [ x | x | x | 0 | 1 | 2 | 3 | 4 | 5 | x | x | x | x ]
+ *
+ * push_front() and push_back() are amortized O(1). When one end runs out of
+ * room, the elements are moved back to the middle of the buffer if it is less
+ * than half full, otherwise they move to a larger buffer chosen by %Growth.
+ * Either way the spare room is split evenly between both ends.
+ *
+ * insert() and erase() in the middle shift the elements on the side of the
+ * position that has fewer of them, so they move at most size() / 2 elements.
+ */
+template <typename Tp, typename Alloc = std::allocator<Tp>,
+          typename Growth = doubling_growth>
+class devector
+{
+public:
+    using value_type      = Tp;
+    using reference       = Tp &;
+    using const_reference = const Tp &;
+    using pointer         = Tp *;
+    using const_pointer   = const Tp *;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using allocator_type = Alloc;
+    using traits_t       = std::allocator_traits<allocator_type>;
+
+    static_assert(std::is_same<typename traits_t::pointer, Tp *>::value,
+                  "devector does not support fancy pointers");
+
+    using iterator               = __normal_iterator<pointer, devector>;
+    using const_iterator         = __normal_iterator<const_pointer, devector>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    devector() noexcept(noexcept(allocator_type()))
+    : devector(allocator_type())
+    {
+    }
+
+    explicit devector(const allocator_type &alloc) noexcept
+    : _alloc(alloc), _buf(), _start(), _finish(), _end()
+    {
+    }
+
+    explicit devector(size_type count,
+                      const allocator_type &alloc = allocator_type())
+    : devector(alloc)
+    {
+        resize(count);
+    }
+
+    devector(size_type count, const_reference value,
+             const allocator_type &alloc = allocator_type())
+    : devector(alloc)
+    {
+        resize(count, value);
+    }
+
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    devector(InputIter first, InputIter last,
+             const allocator_type &alloc = allocator_type())
+    : devector(alloc)
+    {
+        _append_range(first, last);
+    }
+
+    devector(std::initializer_list<value_type> init,
+             const allocator_type &alloc = allocator_type())
+    : devector(init.begin(), init.end(), alloc)
+    {
+    }
+
+    devector(const devector &other)
+    : devector(traits_t::select_on_container_copy_construction(other._alloc))
+    {
+        _append_range(other.begin(), other.end());
+    }
+
+    devector(devector &&other) noexcept
+    : _alloc(std::move(other._alloc)), _buf(), _start(), _finish(), _end()
+    {
+        _steal(other);
+    }
+
+    /**
+     * @brief Copy assignment
+     *
+     * The allocator of %other is copied over if
+     * propagate_on_container_copy_assignment is true, after the memory of
+     * the old one is released if the two are not equal. The buffer is reused
+     * if the elements fit behind the current front, and existing elements are
+     * copy-assigned.
+     */
+    devector &
+    operator=(const devector &other)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_copy_assignment::value)
+        {
+            if (!traits_t::is_always_equal::value && _alloc != other._alloc)
+                _release();
+
+            _alloc = other._alloc;
+        }
+
+        _assign_n(other.begin(), other.size());
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment
+     *
+     * The buffer of %other is taken over if
+     * propagate_on_container_move_assignment is true or both allocators are
+     * equal. Otherwise, the elements are moved one by one into storage from
+     * the current allocator.
+     */
+    devector &
+    operator=(devector &&other) noexcept(
+        traits_t::propagate_on_container_move_assignment::value ||
+        traits_t::is_always_equal::value)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_move_assignment::value)
+        {
+            _release();
+            _alloc = std::move(other._alloc);
+            _steal(other);
+        }
+        else if (traits_t::is_always_equal::value || _alloc == other._alloc)
+        {
+            _release();
+            _steal(other);
+        }
+        else
+        {
+            _assign_n(std::make_move_iterator(other.begin()), other.size());
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    ~devector()
+    {
+        _release();
+    }
+
+    /**
+     * @brief Exchanges the contents of this devector with %other
+     *
+     * Allocators are swapped only if propagate_on_container_swap is true.
+     * Otherwise, they must compare equal.
+     */
+    void
+    swap(devector &other) noexcept
+    {
+        if constexpr (traits_t::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(_alloc, other._alloc);
+        }
+
+        std::swap(_buf, other._buf);
+        std::swap(_start, other._start);
+        std::swap(_finish, other._finish);
+        std::swap(_end, other._end);
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _alloc;
+    }
+
+    iterator
+    begin() noexcept
+    {
+        return iterator(_start);
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(_start);
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return const_iterator(_start);
+    }
+
+    iterator
+    end() noexcept
+    {
+        return iterator(_finish);
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(_finish);
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return const_iterator(_finish);
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    const_reverse_iterator
+    crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    reference
+    operator[](size_type pos) noexcept
+    {
+        return _start[pos];
+    }
+
+    const_reference
+    operator[](size_type pos) const noexcept
+    {
+        return _start[pos];
+    }
+
+    reference
+    at(size_type pos)
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("devector::at");
+
+        return _start[pos];
+    }
+
+    const_reference
+    at(size_type pos) const
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("devector::at");
+
+        return _start[pos];
+    }
+
+    reference
+    front() noexcept
+    {
+        return *_start;
+    }
+
+    const_reference
+    front() const noexcept
+    {
+        return *_start;
+    }
+
+    reference
+    back() noexcept
+    {
+        return *(_finish - 1);
+    }
+
+    const_reference
+    back() const noexcept
+    {
+        return *(_finish - 1);
+    }
+
+    /**
+     * @brief Returns a pointer to the first element
+     *
+     * [data(), data() + size()) is a valid range, even when the devector is
+     * empty.
+     */
+    pointer
+    data() noexcept
+    {
+        return _start;
+    }
+
+    const_pointer
+    data() const noexcept
+    {
+        return _start;
+    }
+
+    _GLIBCXX_NODISCARD bool
+    empty() const noexcept
+    {
+        return _start == _finish;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _finish - _start;
+    }
+
+    /**
+     * @brief Returns the size of the buffer, spare room at both ends included
+     */
+    size_type
+    capacity() const noexcept
+    {
+        return _end - _buf;
+    }
+
+    /**
+     * @brief Returns how many elements push_front() can add without moving
+     * the others
+     */
+    size_type
+    front_free_capacity() const noexcept
+    {
+        return _start - _buf;
+    }
+
+    /**
+     * @brief Returns how many elements push_back() can add without moving
+     * the others
+     */
+    size_type
+    back_free_capacity() const noexcept
+    {
+        return _end - _finish;
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return traits_t::max_size(_alloc);
+    }
+
+    /**
+     * @brief Makes the buffer hold at least %n elements
+     *
+     * The spare room is split evenly between both ends, except in an empty
+     * devector, where it is all left at the back for push_back().
+     */
+    void
+    reserve(size_type n)
+    {
+        if (n > max_size())
+            std::__throw_length_error("devector::reserve");
+
+        if (n > capacity())
+            _reallocate(n, empty() ? 0 : _npos);
+    }
+
+    /**
+     * @brief Makes room for push_back() to grow the devector to %n elements
+     * without moving them, i.e. size() + back_free_capacity() >= n
+     *
+     * The room in front of the elements is kept.
+     */
+    void
+    reserve_back(size_type n)
+    {
+        if (n <= size_type(_end - _start))
+            return;
+
+        if (empty() && n <= capacity())
+        {
+            // Nothing to move, start over at the front of the buffer
+            _start  = _buf;
+            _finish = _buf;
+            return;
+        }
+
+        const size_type front = empty() ? 0 : front_free_capacity();
+
+        if (n > max_size() - front)
+            std::__throw_length_error("devector::reserve_back");
+
+        _reallocate(front + n, front);
+    }
+
+    /**
+     * @brief Makes room for push_front() to grow the devector to %n elements
+     * without moving them, i.e. size() + front_free_capacity() >= n
+     *
+     * The room behind the elements is kept.
+     */
+    void
+    reserve_front(size_type n)
+    {
+        if (n <= size_type(_finish - _buf))
+            return;
+
+        if (empty() && n <= capacity())
+        {
+            _start  = _end;
+            _finish = _end;
+            return;
+        }
+
+        const size_type back = empty() ? 0 : back_free_capacity();
+
+        if (n > max_size() - back)
+            std::__throw_length_error("devector::reserve_front");
+
+        _reallocate(n + back, n - size());
+    }
+
+    void
+    shrink_to_fit()
+    {
+        if (capacity() > size())
+            _reallocate(size());
+    }
+
+    void
+    resize(size_type count)
+    {
+        if (count < size())
+            _erase_at_end(_start + count);
+        else
+        {
+            reserve_back(count);
+            while (size() < count)
+                emplace_back();
+        }
+    }
+
+    void
+    resize(size_type count, const_reference value)
+    {
+        if (count < size())
+            _erase_at_end(_start + count);
+        else
+        {
+            // %value may be an element, keep it valid across reserve().
+            const value_type copy(value);
+
+            reserve_back(count);
+            while (size() < count)
+                emplace_back(copy);
+        }
+    }
+
+    /**
+     * @brief Destroys all elements and centers the empty range in the buffer
+     */
+    void
+    clear() noexcept
+    {
+        _erase_at_end(_start);
+
+        _start  = _buf + capacity() / 2;
+        _finish = _start;
+    }
+
+    void
+    push_back(const_reference value)
+    {
+        emplace_back(value);
+    }
+
+    void
+    push_back(value_type &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    void
+    push_front(const_reference value)
+    {
+        emplace_front(value);
+    }
+
+    void
+    push_front(value_type &&value)
+    {
+        emplace_front(std::move(value));
+    }
+
+    template <typename... Args>
+    reference
+    emplace_back(Args &&...args)
+    {
+        if (_finish != _end)
+        {
+            traits_t::construct(_alloc, _finish, std::forward<Args>(args)...);
+            ++_finish;
+        }
+        else
+            _make_room_emplace(size(), std::forward<Args>(args)...);
+
+        return *(_finish - 1);
+    }
+
+    template <typename... Args>
+    reference
+    emplace_front(Args &&...args)
+    {
+        if (_start != _buf)
+        {
+            traits_t::construct(_alloc, _start - 1,
+                                std::forward<Args>(args)...);
+            --_start;
+        }
+        else
+            _make_room_emplace(0, std::forward<Args>(args)...);
+
+        return *_start;
+    }
+
+    void
+    pop_back() noexcept
+    {
+        --_finish;
+        traits_t::destroy(_alloc, _finish);
+    }
+
+    void
+    pop_front() noexcept
+    {
+        traits_t::destroy(_alloc, _start);
+        ++_start;
+    }
+
+    iterator
+    insert(const_iterator pos, const_reference value)
+    {
+        return emplace(pos, value);
+    }
+
+    iterator
+    insert(const_iterator pos, value_type &&value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    /**
+     * @brief Constructs an element before %pos
+     *
+     * The elements between %pos and the nearer end are shifted by one. If
+     * that end is full, the other end is used, and if both are full, the
+     * elements move to a new buffer with the new one built in place.
+     */
+    template <typename... Args>
+    iterator
+    emplace(const_iterator pos, Args &&...args)
+    {
+        const size_type i = pos - cbegin();
+        const size_type n = size();
+
+        if (i == n)
+            emplace_back(std::forward<Args>(args)...);
+        else if (i == 0)
+            emplace_front(std::forward<Args>(args)...);
+        else if (_start == _buf && _finish == _end)
+            _make_room_emplace(i, std::forward<Args>(args)...);
+        else
+        {
+            const bool front = (i < n - i && _start != _buf) || _finish == _end;
+            _shift_emplace(i, front, std::forward<Args>(args)...);
+        }
+
+        return begin() + i;
+    }
+
+    /**
+     * @brief Removes the element at %pos
+     *
+     * The elements between %pos and the nearer end are shifted by one.
+     * Returns an iterator to the element that followed the removed one.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    /**
+     * @brief Removes the elements in [first, last)
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        const size_type i = first - cbegin();
+        const size_type k = last - first;
+
+        if (k == 0)
+            return begin() + i;
+
+        pointer p = _start + i;
+        pointer q = p + k;
+
+        if (i < size_type(_finish - q))
+        {
+            // Close the hole from the front.
+            std::move_backward(_start, p, q);
+            _erase_at_begin(_start + k);
+        }
+        else
+        {
+            std::move(q, _finish, p);
+            _erase_at_end(_finish - k);
+        }
+
+        return begin() + i;
+    }
+
+private:
+    // Elements can be moved with a bulk byte copy instead of a move-construct
+    // and a destroy per element, see vector::_relocatable.
+    static constexpr bool _relocatable =
+        is_trivially_relocatable_v<Tp> && __alloc_constructs_plainly<Alloc, Tp>;
+
+    allocator_type _alloc;
+    pointer _buf;
+    pointer _start;
+    pointer _finish;
+    pointer _end;
+
+    static void
+    _relocate(pointer first, pointer last, pointer result) noexcept
+    {
+        if (first != last)
+            std::memmove(static_cast<void *>(result),
+                         static_cast<const void *>(first),
+                         (last - first) * sizeof(value_type));
+    }
+
+    /**
+     * @brief Whether a new buffer receives the elements by move or by copy
+     *
+     * As in vector, elements whose move constructor may throw are copied if
+     * they can be, so that a failed reallocation leaves them untouched.
+     */
+    static constexpr bool _move_on_realloc =
+        std::is_nothrow_move_constructible<value_type>::value ||
+        !std::is_copy_constructible<value_type>::value;
+
+    /**
+     * @brief Constructs [first, last) at %result, moving if _move_on_realloc
+     * holds and copying otherwise
+     *
+     * Returns one-past the last constructed element. If a constructor
+     * throws, the elements built so far are destroyed.
+     */
+    pointer
+    _uninitialized_move_if_noexcept(pointer first, pointer last,
+                                    pointer result)
+    {
+        pointer curr = result;
+
+        try
+        {
+            for (; first != last; ++first, ++curr)
+            {
+                if constexpr (_move_on_realloc)
+                    traits_t::construct(_alloc, curr, std::move(*first));
+                else
+                    traits_t::construct(_alloc, curr,
+                                        static_cast<const_reference>(*first));
+            }
+        }
+        catch (...)
+        {
+            for (; curr != result; --curr)
+                traits_t::destroy(_alloc, curr - 1);
+            throw;
+        }
+
+        return curr;
+    }
+
+    /**
+     * @brief Takes over the buffer of %other, leaving it empty
+     */
+    void
+    _steal(devector &other) noexcept
+    {
+        _buf    = other._buf;
+        _start  = other._start;
+        _finish = other._finish;
+        _end    = other._end;
+
+        other._buf    = pointer();
+        other._start  = pointer();
+        other._finish = pointer();
+        other._end    = pointer();
+    }
+
+    void
+    _release() noexcept
+    {
+        _erase_at_end(_start);
+
+        if (_buf)
+            traits_t::deallocate(_alloc, _buf, capacity());
+
+        _buf    = pointer();
+        _start  = pointer();
+        _finish = pointer();
+        _end    = pointer();
+    }
+
+    void
+    _erase_at_end(pointer pos) noexcept
+    {
+        for (pointer curr = pos; curr != _finish; ++curr)
+            traits_t::destroy(_alloc, curr);
+
+        _finish = pos;
+    }
+
+    void
+    _erase_at_begin(pointer pos) noexcept
+    {
+        for (pointer curr = _start; curr != pos; ++curr)
+            traits_t::destroy(_alloc, curr);
+
+        _start = pos;
+    }
+
+    /**
+     * @brief Computes the buffer size needed for %n more elements
+     */
+    size_type
+    _check_len(size_type n, const char *s) const
+    {
+        if (max_size() - size() < n)
+            std::__throw_length_error(s);
+
+        return Growth::template next_capacity<value_type>(
+            capacity(), size() + n, max_size());
+    }
+
+    /**
+     * @brief Moves the elements into a buffer of %new_len elements, leaving
+     * an uninitialized slot at index %hole unless %hole is npos
+     *
+     * The elements start %front slots into the new buffer, or are centered
+     * if %front is npos. Returns the address of the slot. If a constructor
+     * throws, nothing changes (see _move_on_realloc).
+     */
+    pointer
+    _move_to(pointer new_buf, size_type new_len, size_type hole,
+             size_type front = _npos)
+    {
+        const size_type n     = size();
+        const size_type total = n + (hole != _npos);
+        pointer new_start =
+            new_buf + (front != _npos ? front : (new_len - total) / 2);
+        pointer split = hole != _npos ? _start + hole : _finish;
+        pointer slot  = new_start + (split - _start);
+
+        if constexpr (_relocatable)
+        {
+            _relocate(_start, split, new_start);
+            _relocate(split, _finish, slot + (hole != _npos));
+        }
+        else
+        {
+            pointer done =
+                _uninitialized_move_if_noexcept(_start, split, new_start);
+
+            try
+            {
+                _uninitialized_move_if_noexcept(split, _finish,
+                                                slot + (hole != _npos));
+            }
+            catch (...)
+            {
+                for (pointer curr = new_start; curr != done; ++curr)
+                    traits_t::destroy(_alloc, curr);
+                throw;
+            }
+
+            for (pointer curr = _start; curr != _finish; ++curr)
+                traits_t::destroy(_alloc, curr);
+        }
+
+        if (_buf && new_buf != _buf)
+            traits_t::deallocate(_alloc, _buf, capacity());
+
+        _buf    = new_buf;
+        _start  = new_start;
+        _finish = new_start + total;
+        _end    = new_buf + new_len;
+
+        return slot;
+    }
+
+    /**
+     * @brief Moves the elements to a new buffer of %new_len elements, see
+     * _move_to()
+     */
+    void
+    _reallocate(size_type new_len, size_type front = _npos)
+    {
+        pointer new_buf = new_len ? traits_t::allocate(_alloc, new_len)
+                                  : pointer();
+
+        try
+        {
+            _move_to(new_buf, new_len, _npos, front);
+        }
+        catch (...)
+        {
+            traits_t::deallocate(_alloc, new_buf, new_len);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Inserts an element at index %i when the end it goes to is full
+     *
+     * A buffer that is less than half full is recentered in place (through a
+     * temporary, since %args may refer to an element). Otherwise the new
+     * element is built in a larger buffer before the others move there.
+     */
+    template <typename... Args>
+    void
+    _make_room_emplace(size_type i, Args &&...args)
+    {
+        if (size() < capacity() / 2)
+        {
+            value_type tmp(std::forward<Args>(args)...);
+
+            if constexpr (_relocatable)
+                _move_to(_buf, capacity(), _npos);
+            else
+                _reallocate(capacity());
+
+            emplace(cbegin() + i, std::move(tmp));
+            return;
+        }
+
+        const size_type len = _check_len(1, "devector::_make_room_emplace");
+        pointer new_buf     = traits_t::allocate(_alloc, len);
+        pointer slot        = new_buf + (len - size() - 1) / 2 + i;
+
+        try
+        {
+            traits_t::construct(_alloc, slot, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            traits_t::deallocate(_alloc, new_buf, len);
+            throw;
+        }
+
+        try
+        {
+            _move_to(new_buf, len, i);
+        }
+        catch (...)
+        {
+            traits_t::destroy(_alloc, slot);
+            traits_t::deallocate(_alloc, new_buf, len);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Inserts an element at index %i by shifting the elements before
+     * it one slot to the front, or the ones after it one slot to the back
+     *
+     * The chosen end must have room.
+     */
+    template <typename... Args>
+    void
+    _shift_emplace(size_type i, bool front, Args &&...args)
+    {
+        if constexpr (_relocatable)
+        {
+            // Build the new element aside first, as in
+            // vector::_shift_insert().
+            alignas(value_type) unsigned char buf[sizeof(value_type)];
+            pointer tmp = reinterpret_cast<pointer>(buf);
+            traits_t::construct(_alloc, tmp, std::forward<Args>(args)...);
+
+            pointer p = _start + i;
+
+            if (front)
+            {
+                //       s       p                            //
+                // | x | 0 | 1 | 2 | 3 |      ->      | 0 | 1 | ? | 2 | 3 |
+                _relocate(_start, p, _start - 1);
+                --_start;
+                --p;
+            }
+            else
+            {
+                _relocate(p, _finish, p + 1);
+                ++_finish;
+            }
+
+            _relocate(tmp, tmp + 1, p);
+        }
+        else
+        {
+            value_type tmp(std::forward<Args>(args)...);
+            pointer p = _start + i;
+
+            if (front)
+            {
+                traits_t::construct(_alloc, _start - 1, std::move(*_start));
+                --_start;
+                std::move(_start + 2, p, _start + 1);
+                *(p - 1) = std::move(tmp);
+            }
+            else
+            {
+                traits_t::construct(_alloc, _finish, std::move(*(_finish - 1)));
+                ++_finish;
+                std::move_backward(p, _finish - 2, _finish - 1);
+                *p = std::move(tmp);
+            }
+        }
+    }
+
+    template <typename InputIter>
+    void
+    _append_range(InputIter first, InputIter last)
+    {
+        using category =
+            typename std::iterator_traits<InputIter>::iterator_category;
+
+        if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                      category>::value)
+            reserve_back(size() + size_type(std::distance(first, last)));
+
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    /**
+     * @brief Replaces the contents with the %n elements from %first
+     *
+     * Existing elements are assigned in place. The buffer is kept if the new
+     * elements fit behind the current front, and replaced by one of exactly
+     * %n elements otherwise.
+     */
+    template <typename ForwardIter>
+    void
+    _assign_n(ForwardIter first, size_type n)
+    {
+        if (n > size_type(_end - _start))
+        {
+            clear();
+            reserve_back(n);
+        }
+
+        const size_type common = std::min(n, size());
+        pointer curr           = _start;
+
+        for (size_type i = 0; i < common; ++i, ++first, ++curr)
+            *curr = *first;
+
+        if (n < size())
+            _erase_at_end(_start + n);
+        else
+        {
+            for (; size() < n; ++first)
+                emplace_back(*first);
+        }
+    }
+
+    static constexpr size_type _npos = size_type(-1);
+};
+
+template <typename Tp, typename Alloc, typename Growth>
+inline void
+swap(devector<Tp, Alloc, Growth> &lhs,
+     devector<Tp, Alloc, Growth> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+} // namespace dutcpp
+
+#endif
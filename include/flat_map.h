@@ -0,0 +1,1008 @@
+/**
+ * @file flat_map.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A map stored as sorted vectors of keys and values
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef __DUTCPP_FLAT_MAP_H
+#define __DUTCPP_FLAT_MAP_H 1
+
+#include <stdexcept>
+#include <tuple>
+
+#include "flat_set.h"
+
+namespace dutcpp
+{
+/**
+ * @brief Holds the reference returned by an iterator whose elements are
+ * proxies, so that operator->() has something to point to
+ */
+template <typename Reference>
+struct __arrow_proxy
+{
+    Reference _ref;
+
+    Reference *
+    operator->() noexcept
+    {
+        return std::addressof(_ref);
+    }
+};
+
+/**
+ * @brief Random-access iterator over a flat_map
+ *
+ * Walks the key and value vectors side by side. Dereferencing yields a pair
+ * of references, std::pair<const Key &, Tp &>, rather than a reference to a
+ * stored pair.
+ */
+template <typename Key, typename Tp, bool _Const>
+class __flat_map_iterator
+{
+    using mapped_pointer =
+        typename std::conditional<_Const, const Tp *, Tp *>::type;
+    using mapped_reference =
+        typename std::conditional<_Const, const Tp &, Tp &>::type;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = std::pair<Key, Tp>;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = std::pair<const Key &, mapped_reference>;
+    using pointer           = __arrow_proxy<reference>;
+
+    constexpr __flat_map_iterator() noexcept : _key(nullptr), _value(nullptr)
+    {
+    }
+
+    __flat_map_iterator(const Key *key, mapped_pointer value) noexcept
+    : _key(key), _value(value)
+    {
+    }
+
+    template <bool _OtherConst,
+              typename = typename std::enable_if<_Const && !_OtherConst>::type>
+    __flat_map_iterator(
+        const __flat_map_iterator<Key, Tp, _OtherConst> &other) noexcept
+    : _key(other.key_base()), _value(other.value_base())
+    {
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return reference(*_key, *_value);
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return pointer{**this};
+    }
+
+    reference
+    operator[](difference_type n) const noexcept
+    {
+        return reference(_key[n], _value[n]);
+    }
+
+    __flat_map_iterator &
+    operator++() noexcept
+    {
+        ++_key;
+        ++_value;
+        return *this;
+    }
+
+    __flat_map_iterator
+    operator++(int) noexcept
+    {
+        __flat_map_iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    __flat_map_iterator &
+    operator--() noexcept
+    {
+        --_key;
+        --_value;
+        return *this;
+    }
+
+    __flat_map_iterator
+    operator--(int) noexcept
+    {
+        __flat_map_iterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    __flat_map_iterator &
+    operator+=(difference_type n) noexcept
+    {
+        _key += n;
+        _value += n;
+        return *this;
+    }
+
+    __flat_map_iterator &
+    operator-=(difference_type n) noexcept
+    {
+        _key -= n;
+        _value -= n;
+        return *this;
+    }
+
+    friend __flat_map_iterator
+    operator+(__flat_map_iterator it, difference_type n) noexcept
+    {
+        return it += n;
+    }
+
+    friend __flat_map_iterator
+    operator+(difference_type n, __flat_map_iterator it) noexcept
+    {
+        return it += n;
+    }
+
+    friend __flat_map_iterator
+    operator-(__flat_map_iterator it, difference_type n) noexcept
+    {
+        return it -= n;
+    }
+
+    friend difference_type
+    operator-(const __flat_map_iterator &lhs,
+              const __flat_map_iterator &rhs) noexcept
+    {
+        return lhs._key - rhs._key;
+    }
+
+    friend bool
+    operator==(const __flat_map_iterator &lhs,
+               const __flat_map_iterator &rhs) noexcept
+    {
+        return lhs._key == rhs._key;
+    }
+
+    friend bool
+    operator!=(const __flat_map_iterator &lhs,
+               const __flat_map_iterator &rhs) noexcept
+    {
+        return lhs._key != rhs._key;
+    }
+
+    friend bool
+    operator<(const __flat_map_iterator &lhs,
+              const __flat_map_iterator &rhs) noexcept
+    {
+        return lhs._key < rhs._key;
+    }
+
+    friend bool
+    operator>(const __flat_map_iterator &lhs,
+              const __flat_map_iterator &rhs) noexcept
+    {
+        return lhs._key > rhs._key;
+    }
+
+    friend bool
+    operator<=(const __flat_map_iterator &lhs,
+               const __flat_map_iterator &rhs) noexcept
+    {
+        return lhs._key <= rhs._key;
+    }
+
+    friend bool
+    operator>=(const __flat_map_iterator &lhs,
+               const __flat_map_iterator &rhs) noexcept
+    {
+        return lhs._key >= rhs._key;
+    }
+
+    const Key *
+    key_base() const noexcept
+    {
+        return _key;
+    }
+
+    mapped_pointer
+    value_base() const noexcept
+    {
+        return _value;
+    }
+
+private:
+    const Key *_key;
+    mapped_pointer _value;
+};
+
+/**
+ * @brief A sorted map with unique keys, stored as two contiguous vectors
+ *
+ * The keys live in one %KeyContainer in ascending order and the mapped
+ * values in a %MappedContainer at the same positions, so lookups only touch
+ * keys, and iteration is two linear scans. Lookups go through %Layout, as in
+ * flat_set.
+ *
+ * Iterators dereference to std::pair<const Key &, Tp &>. Inserting a range
+ * sorts the new elements and merges them with the old ones in one pass, and
+ * adopt_sorted() takes over key and value vectors that are already sorted
+ * without copying them.
+ *
+ * Iterators are invalidated by every insertion and erasure.
+ */
+template <typename Key, typename Tp, typename Compare = std::less<Key>,
+          typename Layout          = binary_search_layout,
+          typename KeyContainer    = vector<Key>,
+          typename MappedContainer = vector<Tp>>
+class flat_map : private __flat_keys<Key, Compare, Layout, KeyContainer>
+{
+    using base_t = __flat_keys<Key, Compare, Layout, KeyContainer>;
+
+public:
+    using key_type               = Key;
+    using mapped_type            = Tp;
+    using value_type             = std::pair<Key, Tp>;
+    using key_compare            = Compare;
+    using layout_type            = Layout;
+    using key_container_type     = KeyContainer;
+    using mapped_container_type  = MappedContainer;
+    using size_type              = typename KeyContainer::size_type;
+    using difference_type        = typename KeyContainer::difference_type;
+    using reference              = std::pair<const Key &, Tp &>;
+    using const_reference        = std::pair<const Key &, const Tp &>;
+    using iterator               = __flat_map_iterator<Key, Tp, false>;
+    using const_iterator         = __flat_map_iterator<Key, Tp, true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Compares elements by their keys
+     */
+    class value_compare
+    {
+    public:
+        bool
+        operator()(const_reference lhs, const_reference rhs) const
+        {
+            return _comp(lhs.first, rhs.first);
+        }
+
+    private:
+        friend class flat_map;
+
+        explicit value_compare(const key_compare &comp) : _comp(comp) { }
+
+        key_compare _comp;
+    };
+
+    /**
+     * @brief The key and value vectors, as returned by extract()
+     */
+    struct containers
+    {
+        key_container_type keys;
+        mapped_container_type values;
+    };
+
+    /**
+     * @brief Constructs an empty map
+     */
+    flat_map() = default;
+
+    /**
+     * @brief Constructs an empty map ordered by %comp
+     */
+    explicit flat_map(const key_compare &comp) : base_t(comp) { }
+
+    /**
+     * @brief Constructs a map with the elements in [first, last)
+     *
+     * Same as insert(first, last): the elements are sorted once, and only
+     * the first of elements with equivalent keys is kept.
+     */
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    flat_map(InputIter first, InputIter last,
+             const key_compare &comp = key_compare())
+    : base_t(comp)
+    {
+        insert(first, last);
+    }
+
+    /**
+     * @brief Constructs a map with the elements of the %init list
+     */
+    flat_map(std::initializer_list<value_type> init,
+             const key_compare &comp = key_compare())
+    : base_t(comp)
+    {
+        insert(init);
+    }
+
+    /**
+     * @brief Constructs a map with the elements of %range
+     */
+    template <std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>,
+                                     value_type>
+    flat_map(from_range_t, Range &&range,
+             const key_compare &comp = key_compare())
+    : base_t(comp)
+    {
+        insert_range(std::forward<Range>(range));
+    }
+
+    flat_map(const flat_map &)            = default;
+    flat_map &operator=(const flat_map &) = default;
+
+    flat_map(flat_map &&other) noexcept(
+        std::is_nothrow_move_constructible<base_t>::value &&
+        std::is_nothrow_move_constructible<MappedContainer>::value)
+    : base_t(std::move(other)), _values(std::move(other._values))
+    {
+        other._values.clear();
+    }
+
+    flat_map &
+    operator=(flat_map &&other) noexcept(
+        std::is_nothrow_move_assignable<base_t>::value &&
+        std::is_nothrow_move_assignable<MappedContainer>::value)
+    {
+        base_t::operator=(std::move(other));
+        _values = std::move(other._values);
+        other._values.clear();
+
+        return *this;
+    }
+
+    /**
+     * @brief Replaces the elements with those of the %init list
+     */
+    flat_map &
+    operator=(std::initializer_list<value_type> init)
+    {
+        clear();
+        insert(init);
+
+        return *this;
+    }
+
+    iterator
+    begin() noexcept
+    {
+        return iterator(this->_keys.data(), _values.data());
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(this->_keys.data(), _values.data());
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator
+    end() noexcept
+    {
+        return begin() + size();
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return begin() + size();
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return end();
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    crend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return this->_keys.empty();
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return this->_keys.size();
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return std::min<size_type>(this->_keys.max_size(),
+                                   _values.max_size());
+    }
+
+    void
+    reserve(size_type n)
+    {
+        this->_keys.reserve(n);
+        _values.reserve(n);
+    }
+
+    void
+    shrink_to_fit()
+    {
+        this->_keys.shrink_to_fit();
+        _values.shrink_to_fit();
+    }
+
+    /**
+     * @brief Returns the sorted keys
+     */
+    const key_container_type &
+    keys() const noexcept
+    {
+        return this->_keys;
+    }
+
+    /**
+     * @brief Returns the mapped values, in the order of keys()
+     */
+    const mapped_container_type &
+    values() const noexcept
+    {
+        return _values;
+    }
+
+    key_compare
+    key_comp() const
+    {
+        return this->_comp;
+    }
+
+    value_compare
+    value_comp() const
+    {
+        return value_compare(this->_comp);
+    }
+
+    /**
+     * @brief Returns the value mapped to %key, inserting a value-initialized
+     * one first if %key is not present
+     */
+    mapped_type &
+    operator[](const key_type &key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    mapped_type &
+    operator[](key_type &&key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    /**
+     * @brief Returns the value mapped to %key
+     *
+     * Throws std::out_of_range if %key is not present.
+     */
+    mapped_type &
+    at(const key_type &key)
+    {
+        const size_type i = this->_find(key);
+
+        if (i == size())
+            std::__throw_out_of_range("flat_map::at");
+
+        return _values[i];
+    }
+
+    const mapped_type &
+    at(const key_type &key) const
+    {
+        const size_type i = this->_find(key);
+
+        if (i == size())
+            std::__throw_out_of_range("flat_map::at");
+
+        return _values[i];
+    }
+
+    /**
+     * @brief Inserts %value if its key is not present
+     *
+     * Returns an iterator to the element with that key, and whether it was
+     * inserted.
+     */
+    std::pair<iterator, bool>
+    insert(const value_type &value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool>
+    insert(value_type &&value)
+    {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    /**
+     * @brief Inserts an element constructed from %args if its key is not
+     * present
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    emplace(Args &&...args)
+    {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Inserts a value constructed from %args under %key, unless %key
+     * is already present
+     *
+     * Nothing is constructed, and %args are left untouched, if %key is
+     * present.
+     */
+    template <typename K, typename... Args>
+        requires std::constructible_from<key_type, K &&>
+    std::pair<iterator, bool>
+    try_emplace(K &&key, Args &&...args)
+    {
+        const size_type i = this->_lower_bound(key);
+
+        if (i != size() && !this->_comp(key, this->_keys[i]))
+            return {begin() + i, false};
+
+        _emplace_at(i, std::forward<K>(key), std::forward<Args>(args)...);
+
+        return {begin() + i, true};
+    }
+
+    /**
+     * @brief Inserts %value under %key, or assigns it to the value already
+     * mapped to %key
+     */
+    template <typename K, typename M>
+        requires std::constructible_from<key_type, K &&>
+    std::pair<iterator, bool>
+    insert_or_assign(K &&key, M &&value)
+    {
+        const size_type i = this->_lower_bound(key);
+
+        if (i != size() && !this->_comp(key, this->_keys[i]))
+        {
+            _values[i] = std::forward<M>(value);
+            return {begin() + i, false};
+        }
+
+        _emplace_at(i, std::forward<K>(key), std::forward<M>(value));
+
+        return {begin() + i, true};
+    }
+
+    /**
+     * @brief Inserts the elements in [first, last)
+     *
+     * The new elements are gathered and sorted on their own, then merged with
+     * the existing ones in one pass: O(n + m log m) for m new elements
+     * instead of m shifting insertions. Existing keys win over equivalent new
+     * ones, and among new equivalent keys the first one wins.
+     */
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    void
+    insert(InputIter first, InputIter last)
+    {
+        _merge(vector<value_type>(first, last));
+    }
+
+    void
+    insert(std::initializer_list<value_type> init)
+    {
+        insert(init.begin(), init.end());
+    }
+
+    /**
+     * @brief Inserts the elements of %range, see insert(first, last)
+     */
+    template <std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>,
+                                     value_type>
+    void
+    insert_range(Range &&range)
+    {
+        _merge(vector<value_type>(from_range, std::forward<Range>(range)));
+    }
+
+    /**
+     * @brief Replaces the contents with %keys and %values, without copying
+     * them
+     *
+     * %keys must be sorted by key_comp() and hold no equivalent keys, and
+     * %values[i] is the value mapped to %keys[i]. Throws std::length_error,
+     * leaving the map unchanged, if the sizes differ.
+     */
+    void
+    adopt_sorted(key_container_type &&keys, mapped_container_type &&values)
+    {
+        if (keys.size() != values.size())
+            std::__throw_length_error("flat_map::adopt_sorted");
+
+        this->_keys = std::move(keys);
+        _values     = std::move(values);
+
+        try
+        {
+            this->_reindex();
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Moves the keys and values out, leaving the map empty
+     */
+    containers
+    extract() &&
+    {
+        containers c{std::move(this->_keys), std::move(_values)};
+        clear();
+
+        return c;
+    }
+
+    /**
+     * @brief Erases the element at %pos
+     *
+     * Returns an iterator to the element after it.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    iterator
+    erase(iterator pos)
+    {
+        return erase(const_iterator(pos), const_iterator(pos) + 1);
+    }
+
+    /**
+     * @brief Erases the elements in [first, last)
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        const size_type i = first - cbegin();
+        const size_type j = last - cbegin();
+
+        this->_keys.erase(this->_keys.cbegin() + i, this->_keys.cbegin() + j);
+        _values.erase(_values.cbegin() + i, _values.cbegin() + j);
+        this->_reindex();
+
+        return begin() + i;
+    }
+
+    /**
+     * @brief Erases the element with a key equivalent to %key, and returns 1
+     * if there was one or 0 otherwise
+     */
+    size_type
+    erase(const key_type &key)
+    {
+        const size_type i = this->_find(key);
+
+        if (i == size())
+            return 0;
+
+        erase(cbegin() + i);
+        return 1;
+    }
+
+    void
+    clear() noexcept
+    {
+        this->_keys.clear();
+        _values.clear();
+        this->_index.clear();
+    }
+
+    void
+    swap(flat_map &other) noexcept
+    {
+        this->_swap(other);
+        _values.swap(other._values);
+    }
+
+    friend void
+    swap(flat_map &lhs, flat_map &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    iterator
+    find(const key_type &key)
+    {
+        return begin() + this->_find(key);
+    }
+
+    const_iterator
+    find(const key_type &key) const
+    {
+        return begin() + this->_find(key);
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    iterator
+    find(const K &key)
+    {
+        return begin() + this->_find(key);
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    const_iterator
+    find(const K &key) const
+    {
+        return begin() + this->_find(key);
+    }
+
+    bool
+    contains(const key_type &key) const
+    {
+        return this->_find(key) != size();
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    bool
+    contains(const K &key) const
+    {
+        return this->_find(key) != size();
+    }
+
+    size_type
+    count(const key_type &key) const
+    {
+        return contains(key);
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    size_type
+    count(const K &key) const
+    {
+        return contains(key);
+    }
+
+    iterator
+    lower_bound(const key_type &key)
+    {
+        return begin() + this->_lower_bound(key);
+    }
+
+    const_iterator
+    lower_bound(const key_type &key) const
+    {
+        return begin() + this->_lower_bound(key);
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    const_iterator
+    lower_bound(const K &key) const
+    {
+        return begin() + this->_lower_bound(key);
+    }
+
+    iterator
+    upper_bound(const key_type &key)
+    {
+        return begin() + this->_upper_bound(key);
+    }
+
+    const_iterator
+    upper_bound(const key_type &key) const
+    {
+        return begin() + this->_upper_bound(key);
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    const_iterator
+    upper_bound(const K &key) const
+    {
+        return begin() + this->_upper_bound(key);
+    }
+
+    std::pair<iterator, iterator>
+    equal_range(const key_type &key)
+    {
+        const size_type i = this->_lower_bound(key);
+        const size_type j = this->_upper_bound(key);
+
+        return {begin() + i, begin() + j};
+    }
+
+    std::pair<const_iterator, const_iterator>
+    equal_range(const key_type &key) const
+    {
+        const size_type i = this->_lower_bound(key);
+        const size_type j = this->_upper_bound(key);
+
+        return {begin() + i, begin() + j};
+    }
+
+    friend bool
+    operator==(const flat_map &lhs, const flat_map &rhs)
+    {
+        return std::equal(lhs._keys.begin(), lhs._keys.end(),
+                          rhs._keys.begin(), rhs._keys.end()) &&
+               std::equal(lhs._values.begin(), lhs._values.end(),
+                          rhs._values.begin(), rhs._values.end());
+    }
+
+    friend bool
+    operator!=(const flat_map &lhs, const flat_map &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    /**
+     * @brief Inserts the key %key and a value built from %args at index %i
+     *
+     * If anything throws, both vectors are left as they were.
+     */
+    template <typename K, typename... Args>
+    void
+    _emplace_at(size_type i, K &&key, Args &&...args)
+    {
+        this->_keys.emplace(this->_keys.cbegin() + i, std::forward<K>(key));
+
+        try
+        {
+            _values.emplace(_values.cbegin() + i, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            this->_keys.erase(this->_keys.cbegin() + i);
+            throw;
+        }
+
+        try
+        {
+            this->_reindex();
+        }
+        catch (...)
+        {
+            this->_keys.erase(this->_keys.cbegin() + i);
+            _values.erase(_values.cbegin() + i);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Merges the unsorted elements of %tail into the map
+     *
+     * %tail is sorted by key, then one merge pass over the old and new
+     * elements moves them into new key and value vectors, skipping new keys
+     * that are already present. The map is unchanged if an allocation fails,
+     * and cleared if moving an element throws.
+     */
+    void
+    _merge(vector<value_type> &&tail)
+    {
+        auto &comp = this->_comp;
+
+        std::stable_sort(tail.begin(), tail.end(),
+                         [&comp](const value_type &a, const value_type &b) {
+                             return comp(a.first, b.first);
+                         });
+
+        key_container_type keys;
+        mapped_container_type values;
+        keys.reserve(size() + tail.size());
+        values.reserve(size() + tail.size());
+
+        auto append = [&](auto &&key, auto &&value) {
+            // Equivalent to the last key taken: that one was older, or came
+            // first among the new elements
+            if (!keys.empty() && !comp(keys.back(), key))
+                return;
+
+            keys.push_back(std::forward<decltype(key)>(key));
+            values.push_back(std::forward<decltype(value)>(value));
+        };
+
+        size_type i = 0;
+        auto it     = tail.begin();
+
+        try
+        {
+            while (i != size() || it != tail.end())
+            {
+                if (it == tail.end() ||
+                    (i != size() && !comp(it->first, this->_keys[i])))
+                {
+                    append(std::move(this->_keys[i]), std::move(_values[i]));
+                    ++i;
+                }
+                else
+                {
+                    append(std::move(it->first), std::move(it->second));
+                    ++it;
+                }
+            }
+
+            this->_keys = std::move(keys);
+            _values     = std::move(values);
+            this->_reindex();
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    MappedContainer _values;
+};
+} // namespace dutcpp
+
+#endif // __DUTCPP_FLAT_MAP_H
@@ -0,0 +1,900 @@
+/**
+ * @file flat_set.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A set stored as a sorted vector of keys
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef __DUTCPP_FLAT_SET_H
+#define __DUTCPP_FLAT_SET_H 1
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "vector.h"
+
+namespace dutcpp
+{
+/**
+ * @brief Hints the CPU to load the cache line %bytes past %base
+ *
+ * The address may be past the end of the array; prefetches never fault.
+ */
+inline void
+__prefetch(const void *base, std::size_t bytes) noexcept
+{
+    __builtin_prefetch(
+        reinterpret_cast<const void *>(
+            reinterpret_cast<std::uintptr_t>(base) + bytes));
+}
+
+/**
+ * @brief Returns the first index in the sorted %keys[0, n) whose key is not
+ * less than %key
+ *
+ * The loop halves the range without a data-dependent branch, so the search
+ * costs log2(n) loads and no branch misprediction.
+ */
+template <typename Key, typename K, typename Compare>
+inline std::size_t
+__branchless_lower_bound(const Key *keys, std::size_t n, const K &key,
+                         const Compare &comp)
+{
+    if (n == 0)
+        return 0;
+
+    const Key *base = keys;
+
+    while (n > 1)
+    {
+        const std::size_t half = n / 2;
+        base                   = comp(base[half - 1], key) ? base + half : base;
+        n -= half;
+    }
+
+    return (base - keys) + comp(*base, key);
+}
+
+/**
+ * @brief Lookup layout of flat_set and flat_map: binary search over the
+ * sorted keys
+ *
+ * Needs no memory besides the keys. Each step of the search loads from a
+ * cache line far away from the previous one, which makes lookups in large
+ * tables bound by memory latency.
+ */
+struct binary_search_layout
+{
+    template <typename Key, typename Compare>
+    class index
+    {
+    public:
+        void
+        rebuild(const Key *, std::size_t)
+        {
+        }
+
+        void
+        clear() noexcept
+        {
+        }
+
+        template <typename K>
+        std::size_t
+        lower_bound(const Key *keys, std::size_t n, const K &key,
+                    const Compare &comp) const
+        {
+            return __branchless_lower_bound(keys, n, key, comp);
+        }
+
+        template <typename K>
+        std::size_t
+        find(const Key *keys, std::size_t n, const K &key,
+             const Compare &comp) const
+        {
+            const std::size_t i = lower_bound(keys, n, key, comp);
+
+            return (i != n && !comp(key, keys[i])) ? i : n;
+        }
+    };
+};
+
+/**
+ * @brief Lookup layout of flat_set and flat_map: an Eytzinger copy of the
+ * keys
+ *
+ * The keys are also kept in breadth-first order of the implicit search tree
+ * whose node k has children 2k and 2k + 1:
+ *
+ *               3
+ *           /       \      sorted: | 0 | 1 | 2 | 3 | 4 | 5 | 6 |
+ *         1           5
+ *       /   \       /   \  tree:   | 3 | 1 | 5 | 0 | 2 | 4 | 6 |
+ *      0     2     4     6            k=1 k=2 k=3 k=4 k=5 k=6 k=7
+ *
+ * The first levels share a few hot cache lines, and the descendants of a
+ * node a few levels down are contiguous, so they are prefetched while the
+ * search goes on. The position of a node in the sorted keys is computed from
+ * k, so a lookup touches nothing but the tree.
+ *
+ * This costs a copy of the keys, and every modification rebuilds it in O(n):
+ * it is meant for tables that are built once, or in bulk, and read many
+ * times.
+ */
+struct eytzinger_layout
+{
+    template <typename Key, typename Compare>
+    class index
+    {
+    public:
+        /**
+         * @brief Rebuilds the tree from the sorted %keys[0, n)
+         */
+        void
+        rebuild(const Key *keys, std::size_t n)
+        {
+            _tree.clear();
+            _tree.reserve(n);
+
+            for (std::size_t k = 1; k <= n; ++k)
+                _tree.push_back(keys[_rank(k, n)]);
+        }
+
+        void
+        clear() noexcept
+        {
+            _tree.clear();
+        }
+
+        template <typename K>
+        std::size_t
+        lower_bound(const Key *, std::size_t n, const K &key,
+                    const Compare &comp) const
+        {
+            const std::size_t k = _search(n, key, comp);
+
+            return k ? _rank(k, n) : n;
+        }
+
+        template <typename K>
+        std::size_t
+        find(const Key *, std::size_t n, const K &key,
+             const Compare &comp) const
+        {
+            // The last node visited is still in cache, unlike the sorted keys
+            const std::size_t k = _search(n, key, comp);
+
+            return (k && !comp(key, _tree[k - 1])) ? _rank(k, n) : n;
+        }
+
+    private:
+        /**
+         * @brief Returns the node of the first key not less than %key, or 0
+         */
+        template <typename K>
+        std::size_t
+        _search(std::size_t n, const K &key, const Compare &comp) const
+        {
+            // The 2^d descendants of node k, d levels down, are contiguous
+            // from node k * 2^d. With 2^d keys per cache line, the line that
+            // holds them is fetched d steps before the search gets there.
+            constexpr std::size_t block = 64 / sizeof(Key);
+
+            const Key *tree = _tree.data();
+            std::size_t k   = 1;
+
+            while (k <= n)
+            {
+                if constexpr (block > 1)
+                    __prefetch(tree, (k * block - 1) * sizeof(Key));
+
+                k = 2 * k + comp(tree[k - 1], key);
+            }
+
+            // Every step right appended a 1. Dropping the trailing ones and
+            // the last 0 leads back to the last node where the search went
+            // left.
+            return k >> (std::countr_one(k) + 1);
+        }
+
+        /**
+         * @brief Returns the position in the sorted keys of node %k of a tree
+         * of %n nodes
+         *
+         * In a perfect tree of height h, node k at depth d comes after
+         * (2 (k - 2^d) + 1) 2^(h - d) - 1 nodes in order, and the leaves take
+         * every other position. The last level of this tree is only filled
+         * up to node n, so the missing leaves before k are subtracted.
+         */
+        static std::size_t
+        _rank(std::size_t k, std::size_t n) noexcept
+        {
+            const int h = std::bit_width(n) - 1;
+            const int d = std::bit_width(k) - 1;
+
+            const std::size_t r =
+                ((2 * (k - (std::size_t(1) << d)) + 1) << (h - d)) - 1;
+            const std::size_t leaves = n - (std::size_t(1) << h) + 1;
+            const std::size_t before = (r + 1) / 2;
+
+            return r - (before > leaves ? before - leaves : 0);
+        }
+
+        vector<Key> _tree;
+    };
+};
+
+/**
+ * @brief Sorted keys, comparator and lookup index shared by flat_set and
+ * flat_map
+ */
+template <typename Key, typename Compare, typename Layout,
+          typename KeyContainer>
+class __flat_keys
+{
+protected:
+    using size_type = typename KeyContainer::size_type;
+
+    __flat_keys() = default;
+
+    explicit __flat_keys(const Compare &comp) : _keys(), _comp(comp) { }
+
+    __flat_keys(const __flat_keys &) = default;
+
+    __flat_keys(__flat_keys &&other) noexcept(
+        std::is_nothrow_move_constructible<KeyContainer>::value &&
+        std::is_nothrow_move_constructible<Compare>::value)
+    : _keys(std::move(other._keys)), _comp(other._comp),
+      _index(std::move(other._index))
+    {
+        other._index.clear();
+    }
+
+    __flat_keys &operator=(const __flat_keys &) = default;
+
+    __flat_keys &
+    operator=(__flat_keys &&other) noexcept(
+        std::is_nothrow_move_assignable<KeyContainer>::value)
+    {
+        _keys  = std::move(other._keys);
+        _comp  = other._comp;
+        _index = std::move(other._index);
+        other._keys.clear();
+        other._index.clear();
+
+        return *this;
+    }
+
+    void
+    _swap(__flat_keys &other) noexcept
+    {
+        using std::swap;
+
+        _keys.swap(other._keys);
+        swap(_comp, other._comp);
+        swap(_index, other._index);
+    }
+
+    /**
+     * @brief Index of the first key not less than %key
+     */
+    template <typename K>
+    size_type
+    _lower_bound(const K &key) const
+    {
+        return _index.lower_bound(_keys.data(), _keys.size(), key, _comp);
+    }
+
+    /**
+     * @brief Index of the key equivalent to %key, or size() if there is none
+     */
+    template <typename K>
+    size_type
+    _find(const K &key) const
+    {
+        return _index.find(_keys.data(), _keys.size(), key, _comp);
+    }
+
+    /**
+     * @brief Index of the first key greater than %key
+     */
+    template <typename K>
+    size_type
+    _upper_bound(const K &key) const
+    {
+        const size_type i = _lower_bound(key);
+
+        return (i != _keys.size() && !_comp(key, _keys[i])) ? i + 1 : i;
+    }
+
+    /**
+     * @brief Brings the lookup index up to date after the keys changed
+     */
+    void
+    _reindex()
+    {
+        _index.rebuild(_keys.data(), _keys.size());
+    }
+
+    KeyContainer _keys;
+    [[no_unique_address]] Compare _comp;
+    [[no_unique_address]] typename Layout::template index<Key, Compare> _index;
+};
+
+template <typename Compare, typename = void>
+inline constexpr bool __is_transparent = false;
+
+template <typename Compare>
+inline constexpr bool
+    __is_transparent<Compare, std::void_t<typename Compare::is_transparent>> =
+        true;
+
+/**
+ * @brief A sorted set of unique keys stored contiguously
+ *
+ * The keys live in one %KeyContainer (a dutcpp::vector by default) in
+ * ascending order, so iteration is a linear scan and there is no node per
+ * key. Lookups go through %Layout: binary_search_layout searches the keys
+ * themselves, eytzinger_layout keeps a cache-friendlier copy for read-mostly
+ * tables.
+ *
+ * Inserting or erasing one key shifts the keys after it, like
+ * vector::insert(). Inserting a range appends it, sorts the new keys and
+ * merges them with the old ones in one pass, and adopt_sorted() takes over a
+ * vector that is already sorted without copying it.
+ *
+ * Keys are immutable through iterators, and iterators are invalidated by
+ * every insertion and erasure.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+          typename Layout = binary_search_layout,
+          typename KeyContainer = vector<Key>>
+class flat_set : private __flat_keys<Key, Compare, Layout, KeyContainer>
+{
+    using base_t = __flat_keys<Key, Compare, Layout, KeyContainer>;
+
+public:
+    using key_type               = Key;
+    using value_type             = Key;
+    using key_compare            = Compare;
+    using value_compare          = Compare;
+    using layout_type            = Layout;
+    using container_type         = KeyContainer;
+    using size_type              = typename KeyContainer::size_type;
+    using difference_type        = typename KeyContainer::difference_type;
+    using reference              = value_type &;
+    using const_reference        = const value_type &;
+    using iterator               = typename KeyContainer::const_iterator;
+    using const_iterator         = typename KeyContainer::const_iterator;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Constructs an empty set
+     */
+    flat_set() = default;
+
+    /**
+     * @brief Constructs an empty set ordered by %comp
+     */
+    explicit flat_set(const key_compare &comp) : base_t(comp) { }
+
+    /**
+     * @brief Constructs a set with the keys in [first, last)
+     *
+     * Same as insert(first, last): the keys are sorted once, and only the
+     * first of equivalent keys is kept.
+     */
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    flat_set(InputIter first, InputIter last,
+             const key_compare &comp = key_compare())
+    : base_t(comp)
+    {
+        insert(first, last);
+    }
+
+    /**
+     * @brief Constructs a set with the keys of the %init list
+     */
+    flat_set(std::initializer_list<value_type> init,
+             const key_compare &comp = key_compare())
+    : base_t(comp)
+    {
+        insert(init);
+    }
+
+    /**
+     * @brief Constructs a set with the keys of %range
+     */
+    template <std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>,
+                                     value_type>
+    flat_set(from_range_t, Range &&range,
+             const key_compare &comp = key_compare())
+    : base_t(comp)
+    {
+        insert_range(std::forward<Range>(range));
+    }
+
+    flat_set(const flat_set &)                = default;
+    flat_set(flat_set &&) noexcept            = default;
+    flat_set &operator=(const flat_set &)     = default;
+    flat_set &operator=(flat_set &&) noexcept = default;
+
+    /**
+     * @brief Replaces the keys with those of the %init list
+     */
+    flat_set &
+    operator=(std::initializer_list<value_type> init)
+    {
+        clear();
+        insert(init);
+
+        return *this;
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return this->_keys.cbegin();
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return this->_keys.cbegin();
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return this->_keys.cend();
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return this->_keys.cend();
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    crend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return this->_keys.empty();
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return this->_keys.size();
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return this->_keys.max_size();
+    }
+
+    void
+    reserve(size_type n)
+    {
+        this->_keys.reserve(n);
+    }
+
+    void
+    shrink_to_fit()
+    {
+        this->_keys.shrink_to_fit();
+    }
+
+    /**
+     * @brief Returns the sorted keys
+     */
+    const container_type &
+    keys() const noexcept
+    {
+        return this->_keys;
+    }
+
+    key_compare
+    key_comp() const
+    {
+        return this->_comp;
+    }
+
+    value_compare
+    value_comp() const
+    {
+        return this->_comp;
+    }
+
+    /**
+     * @brief Inserts %value if no equivalent key is present
+     *
+     * Returns an iterator to the key equivalent to %value, and whether it was
+     * inserted.
+     */
+    std::pair<iterator, bool>
+    insert(const value_type &value)
+    {
+        return _insert_unique(value);
+    }
+
+    std::pair<iterator, bool>
+    insert(value_type &&value)
+    {
+        return _insert_unique(std::move(value));
+    }
+
+    /**
+     * @brief Same as insert(value), %hint is ignored
+     */
+    iterator
+    insert(const_iterator, const value_type &value)
+    {
+        return _insert_unique(value).first;
+    }
+
+    iterator
+    insert(const_iterator, value_type &&value)
+    {
+        return _insert_unique(std::move(value)).first;
+    }
+
+    /**
+     * @brief Inserts a key constructed from %args if no equivalent key is
+     * present
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    emplace(Args &&...args)
+    {
+        return _insert_unique(value_type(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Inserts the keys in [first, last)
+     *
+     * The keys are appended, sorted and merged with the existing ones, then
+     * duplicates are dropped: O(n + m log m) for m new keys instead of m
+     * shifting insertions. Existing keys win over equivalent new ones, and
+     * among new equivalent keys the first one wins.
+     */
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    void
+    insert(InputIter first, InputIter last)
+    {
+        const size_type old_size = size();
+
+        this->_keys.insert(this->_keys.cend(), first, last);
+        _merge_tail(old_size);
+    }
+
+    void
+    insert(std::initializer_list<value_type> init)
+    {
+        insert(init.begin(), init.end());
+    }
+
+    /**
+     * @brief Inserts the keys of %range, see insert(first, last)
+     */
+    template <std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>,
+                                     value_type>
+    void
+    insert_range(Range &&range)
+    {
+        const size_type old_size = size();
+
+        this->_keys.append_range(std::forward<Range>(range));
+        _merge_tail(old_size);
+    }
+
+    /**
+     * @brief Replaces the contents with %keys, without copying them
+     *
+     * %keys must be sorted by key_comp() and hold no equivalent keys.
+     */
+    void
+    adopt_sorted(container_type &&keys)
+    {
+        this->_keys = std::move(keys);
+
+        try
+        {
+            this->_reindex();
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Moves the sorted keys out, leaving the set empty
+     */
+    container_type
+    extract() &&
+    {
+        container_type keys = std::move(this->_keys);
+        clear();
+
+        return keys;
+    }
+
+    /**
+     * @brief Erases the key at %pos
+     *
+     * Returns an iterator to the key after it.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        const size_type i = pos - begin();
+
+        this->_keys.erase(pos);
+        this->_reindex();
+
+        return begin() + i;
+    }
+
+    /**
+     * @brief Erases the keys in [first, last)
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        const size_type i = first - begin();
+
+        this->_keys.erase(first, last);
+        this->_reindex();
+
+        return begin() + i;
+    }
+
+    /**
+     * @brief Erases the key equivalent to %key, and returns 1 if there was
+     * one or 0 otherwise
+     */
+    size_type
+    erase(const key_type &key)
+    {
+        const size_type i = this->_find(key);
+
+        if (i == size())
+            return 0;
+
+        erase(begin() + i);
+        return 1;
+    }
+
+    void
+    clear() noexcept
+    {
+        this->_keys.clear();
+        this->_index.clear();
+    }
+
+    void
+    swap(flat_set &other) noexcept
+    {
+        this->_swap(other);
+    }
+
+    friend void
+    swap(flat_set &lhs, flat_set &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    const_iterator
+    find(const key_type &key) const
+    {
+        return begin() + this->_find(key);
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    const_iterator
+    find(const K &key) const
+    {
+        return begin() + this->_find(key);
+    }
+
+    bool
+    contains(const key_type &key) const
+    {
+        return this->_find(key) != size();
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    bool
+    contains(const K &key) const
+    {
+        return this->_find(key) != size();
+    }
+
+    size_type
+    count(const key_type &key) const
+    {
+        return contains(key);
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    size_type
+    count(const K &key) const
+    {
+        return contains(key);
+    }
+
+    const_iterator
+    lower_bound(const key_type &key) const
+    {
+        return begin() + this->_lower_bound(key);
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    const_iterator
+    lower_bound(const K &key) const
+    {
+        return begin() + this->_lower_bound(key);
+    }
+
+    const_iterator
+    upper_bound(const key_type &key) const
+    {
+        return begin() + this->_upper_bound(key);
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    const_iterator
+    upper_bound(const K &key) const
+    {
+        return begin() + this->_upper_bound(key);
+    }
+
+    std::pair<const_iterator, const_iterator>
+    equal_range(const key_type &key) const
+    {
+        return _equal_range(key);
+    }
+
+    template <typename K>
+        requires __is_transparent<Compare>
+    std::pair<const_iterator, const_iterator>
+    equal_range(const K &key) const
+    {
+        return _equal_range(key);
+    }
+
+    friend bool
+    operator==(const flat_set &lhs, const flat_set &rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool
+    operator!=(const flat_set &lhs, const flat_set &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    template <typename Arg>
+    std::pair<iterator, bool>
+    _insert_unique(Arg &&value)
+    {
+        const size_type i = this->_lower_bound(value);
+
+        if (i != size() && !this->_comp(value, this->_keys[i]))
+            return {begin() + i, false};
+
+        this->_keys.emplace(this->_keys.cbegin() + i,
+                            std::forward<Arg>(value));
+
+        try
+        {
+            this->_reindex();
+        }
+        catch (...)
+        {
+            this->_keys.erase(this->_keys.cbegin() + i);
+            throw;
+        }
+
+        return {begin() + i, true};
+    }
+
+    /**
+     * @brief Sorts the keys appended after %old_size and merges them into
+     * the sorted keys before it
+     */
+    void
+    _merge_tail(size_type old_size)
+    {
+        auto &keys = this->_keys;
+        auto &comp = this->_comp;
+        auto mid   = keys.begin() + old_size;
+
+        try
+        {
+            std::stable_sort(mid, keys.end(), comp);
+
+            // Nothing to merge if the new keys all go after the old ones
+            if (old_size != 0 && mid != keys.end() && comp(*mid, *(mid - 1)))
+                std::inplace_merge(keys.begin(), mid, keys.end(), comp);
+
+            // The merge is stable, so the first of equivalent keys is the
+            // oldest one.
+            keys.erase(std::unique(keys.begin(), keys.end(),
+                                   [&comp](const Key &a, const Key &b) {
+                                       return !comp(a, b);
+                                   }),
+                       keys.end());
+
+            this->_reindex();
+        }
+        catch (...)
+        {
+            // The order of the keys is unknown
+            clear();
+            throw;
+        }
+    }
+
+    template <typename K>
+    std::pair<const_iterator, const_iterator>
+    _equal_range(const K &key) const
+    {
+        const size_type i = this->_lower_bound(key);
+        const size_type j =
+            (i != size() && !this->_comp(key, this->_keys[i])) ? i + 1 : i;
+
+        return {begin() + i, begin() + j};
+    }
+};
+} // namespace dutcpp
+
+#endif // __DUTCPP_FLAT_SET_H
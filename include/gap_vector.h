@@ -0,0 +1,893 @@
+/**
+ * @file gap_vector.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A vector that keeps its free capacity at the last edit point
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef __DUTCPP_GAP_VECTOR_H
+#define __DUTCPP_GAP_VECTOR_H 1
+
+#include <span>
+
+#include "vector.h"
+
+namespace dutcpp
+{
+/**
+ * @brief A gap buffer
+ *
+ * The free capacity is kept as a gap inside the buffer, at the position of
+ * the last insertion or erasure:
+ *
+ *     _start          _gap_start        _gap_end             _end
+ *      |                  |                 |                  |
+ *      v                  v                 v                  v
+ *      [ 0 | 1 | 2 | 3 | 4 | x | x | x | x | 5 | 6 | 7 | 8 | 9 ]
+ *
+ * Inserting or erasing at the gap is O(1), as nothing has to shift. Editing
+ * elsewhere first moves the gap there, which moves the elements in between,
+ * so a run of edits close to each other (typing in an editor, merging a
+ * batch into a sorted log) costs the distance between them rather than
+ * size() per edit as with vector::insert().
+ *
+ * The elements are contiguous only when the gap is at one end. compact()
+ * moves it to the back and returns the elements as a span.
+ */
+template <typename Tp, typename Alloc = std::allocator<Tp>,
+          typename Growth = doubling_growth>
+class gap_vector
+{
+public:
+    using value_type      = Tp;
+    using reference       = Tp &;
+    using const_reference = const Tp &;
+    using pointer         = Tp *;
+    using const_pointer   = const Tp *;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using allocator_type = Alloc;
+    using traits_t       = std::allocator_traits<allocator_type>;
+
+    static_assert(std::is_same<typename traits_t::pointer, Tp *>::value,
+                  "gap_vector does not support fancy pointers");
+
+    using iterator               = __indexed_iterator<gap_vector, false>;
+    using const_iterator         = __indexed_iterator<gap_vector, true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    gap_vector() noexcept(noexcept(allocator_type()))
+    : gap_vector(allocator_type())
+    {
+    }
+
+    explicit gap_vector(const allocator_type &alloc) noexcept
+    : _alloc(alloc), _start(), _gap_start(), _gap_end(), _end()
+    {
+    }
+
+    gap_vector(size_type count, const_reference value,
+               const allocator_type &alloc = allocator_type())
+    : gap_vector(alloc)
+    {
+        reserve(count);
+        for (size_type i = 0; i < count; ++i)
+            _append(value);
+    }
+
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    gap_vector(InputIter first, InputIter last,
+               const allocator_type &alloc = allocator_type())
+    : gap_vector(alloc)
+    {
+        insert(cend(), first, last);
+    }
+
+    gap_vector(std::initializer_list<value_type> init,
+               const allocator_type &alloc = allocator_type())
+    : gap_vector(init.begin(), init.end(), alloc)
+    {
+    }
+
+    gap_vector(const gap_vector &other)
+    : gap_vector(traits_t::select_on_container_copy_construction(other._alloc))
+    {
+        insert(cend(), other.begin(), other.end());
+    }
+
+    gap_vector(gap_vector &&other) noexcept
+    : _alloc(std::move(other._alloc)), _start(), _gap_start(), _gap_end(),
+      _end()
+    {
+        _steal(other);
+    }
+
+    /**
+     * @brief Copy assignment
+     *
+     * The allocator of %other is copied over if
+     * propagate_on_container_copy_assignment is true, after the memory of
+     * the old one is released if the two are not equal. Existing elements are
+     * copy-assigned and the buffer is reused if it is large enough.
+     */
+    gap_vector &
+    operator=(const gap_vector &other)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_copy_assignment::value)
+        {
+            if (!traits_t::is_always_equal::value && _alloc != other._alloc)
+                _release();
+
+            _alloc = other._alloc;
+        }
+
+        _assign_n(other.begin(), other.size());
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment
+     *
+     * The buffer of %other is taken over if
+     * propagate_on_container_move_assignment is true or both allocators are
+     * equal. Otherwise, the elements are moved one by one into storage from
+     * the current allocator.
+     */
+    gap_vector &
+    operator=(gap_vector &&other) noexcept(
+        traits_t::propagate_on_container_move_assignment::value ||
+        traits_t::is_always_equal::value)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_move_assignment::value)
+        {
+            _release();
+            _alloc = std::move(other._alloc);
+            _steal(other);
+        }
+        else if (traits_t::is_always_equal::value || _alloc == other._alloc)
+        {
+            _release();
+            _steal(other);
+        }
+        else
+        {
+            _assign_n(std::make_move_iterator(other.begin()), other.size());
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    ~gap_vector()
+    {
+        _release();
+    }
+
+    /**
+     * @brief Exchanges the contents of this gap_vector with %other
+     *
+     * Allocators are swapped only if propagate_on_container_swap is true.
+     * Otherwise, they must compare equal.
+     */
+    void
+    swap(gap_vector &other) noexcept
+    {
+        if constexpr (traits_t::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(_alloc, other._alloc);
+        }
+
+        std::swap(_start, other._start);
+        std::swap(_gap_start, other._gap_start);
+        std::swap(_gap_end, other._gap_end);
+        std::swap(_end, other._end);
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _alloc;
+    }
+
+    iterator
+    begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    iterator
+    end() noexcept
+    {
+        return iterator(this, size());
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(this, size());
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return const_iterator(this, size());
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    const_reverse_iterator
+    crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    reference
+    operator[](size_type pos) noexcept
+    {
+        return *_slot(pos);
+    }
+
+    const_reference
+    operator[](size_type pos) const noexcept
+    {
+        return *_slot(pos);
+    }
+
+    reference
+    at(size_type pos)
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("gap_vector::at");
+
+        return *_slot(pos);
+    }
+
+    const_reference
+    at(size_type pos) const
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("gap_vector::at");
+
+        return *_slot(pos);
+    }
+
+    reference
+    front() noexcept
+    {
+        return *_slot(0);
+    }
+
+    const_reference
+    front() const noexcept
+    {
+        return *_slot(0);
+    }
+
+    reference
+    back() noexcept
+    {
+        return *_slot(size() - 1);
+    }
+
+    const_reference
+    back() const noexcept
+    {
+        return *_slot(size() - 1);
+    }
+
+    _GLIBCXX_NODISCARD bool
+    empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return capacity() - gap_size();
+    }
+
+    size_type
+    capacity() const noexcept
+    {
+        return _end - _start;
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return traits_t::max_size(_alloc);
+    }
+
+    /**
+     * @brief Returns the index of the first element after the gap
+     */
+    size_type
+    gap_position() const noexcept
+    {
+        return _gap_start - _start;
+    }
+
+    /**
+     * @brief Returns the number of free slots in the gap
+     */
+    size_type
+    gap_size() const noexcept
+    {
+        return _gap_end - _gap_start;
+    }
+
+    /**
+     * @brief Moves the gap in front of the element at %pos
+     *
+     * O(distance) moves. Elements cross the gap one at a time, so if a move
+     * constructor throws, every element is still in place, just not all of
+     * them on the side of the gap they were headed to.
+     */
+    void
+    move_gap(size_type pos)
+    {
+        const size_type gap = gap_position();
+
+        if (_gap_start == _gap_end)
+        {
+            // An empty gap can be anywhere, nothing moves.
+            _gap_start = _start + pos;
+            _gap_end   = _gap_start;
+        }
+        else if (pos < gap)
+        {
+            //                 pos      gap
+            // | 0 | 1 | 2 | 3 | 4 | 5 | x | x | 6 |                          //
+            //                      v
+            // | 0 | 1 | 2 | 3 | x | x | 4 | 5 | 6 |                          //
+            const size_type k = gap - pos;
+
+            if constexpr (_relocatable)
+                _relocate(_gap_start - k, _gap_start, _gap_end - k);
+            else
+            {
+                for (size_type i = 0; i < k; ++i)
+                    _cross(_gap_start - 1, _gap_end - 1);
+                return;
+            }
+
+            _gap_start -= k;
+            _gap_end   -= k;
+        }
+        else if (pos > gap)
+        {
+            const size_type k = pos - gap;
+
+            if constexpr (_relocatable)
+                _relocate(_gap_end, _gap_end + k, _gap_start);
+            else
+            {
+                for (size_type i = 0; i < k; ++i)
+                    _cross(_gap_end, _gap_start);
+                return;
+            }
+
+            _gap_start += k;
+            _gap_end   += k;
+        }
+    }
+
+    /**
+     * @brief Moves the gap to the back and returns the elements as one
+     * contiguous span
+     */
+    std::span<value_type>
+    compact()
+    {
+        move_gap(size());
+        return std::span<value_type>(_start, size());
+    }
+
+    void
+    reserve(size_type n)
+    {
+        if (n > max_size())
+            std::__throw_length_error("gap_vector::reserve");
+
+        if (n > capacity())
+            _reallocate(n);
+    }
+
+    void
+    shrink_to_fit()
+    {
+        if (gap_size() > 0)
+            _reallocate(size());
+    }
+
+    void
+    clear() noexcept
+    {
+        _destroy(_start, _gap_start);
+        _destroy(_gap_end, _end);
+
+        _gap_start = _start;
+        _gap_end   = _end;
+    }
+
+    void
+    push_back(const_reference value)
+    {
+        emplace(cend(), value);
+    }
+
+    void
+    push_back(value_type &&value)
+    {
+        emplace(cend(), std::move(value));
+    }
+
+    template <typename... Args>
+    reference
+    emplace_back(Args &&...args)
+    {
+        return *emplace(cend(), std::forward<Args>(args)...);
+    }
+
+    void
+    pop_back()
+    {
+        erase(cend() - 1);
+    }
+
+    iterator
+    insert(const_iterator pos, const_reference value)
+    {
+        return emplace(pos, value);
+    }
+
+    iterator
+    insert(const_iterator pos, value_type &&value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    /**
+     * @brief Inserts the elements in [first, last) before %pos
+     *
+     * The gap is moved to %pos once, then the elements are constructed into
+     * it one after the other.
+     */
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    iterator
+    insert(const_iterator pos, InputIter first, InputIter last)
+    {
+        using category =
+            typename std::iterator_traits<InputIter>::iterator_category;
+
+        const size_type i = pos.index();
+
+        if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                      category>::value)
+        {
+            const size_type n = std::distance(first, last);
+
+            if (n > gap_size())
+                _reallocate(_check_len(n, "gap_vector::insert"), i);
+        }
+
+        move_gap(i);
+
+        for (; first != last; ++first)
+            _append(*first);
+
+        return begin() + i;
+    }
+
+    iterator
+    insert(const_iterator pos, std::initializer_list<value_type> init)
+    {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    /**
+     * @brief Constructs an element before %pos
+     *
+     * O(1) if %pos is at the gap and the gap is not empty. %args may refer to
+     * an element of this gap_vector.
+     */
+    template <typename... Args>
+    iterator
+    emplace(const_iterator pos, Args &&...args)
+    {
+        const size_type i = pos.index();
+
+        if (i == gap_position() && _gap_start != _gap_end)
+        {
+            traits_t::construct(_alloc, _gap_start,
+                                std::forward<Args>(args)...);
+            ++_gap_start;
+        }
+        else if (_gap_start == _gap_end)
+            _realloc_emplace(i, std::forward<Args>(args)...);
+        else
+        {
+            // Moving the gap may move the element %args refers to.
+            value_type tmp(std::forward<Args>(args)...);
+            move_gap(i);
+            traits_t::construct(_alloc, _gap_start, std::move(tmp));
+            ++_gap_start;
+        }
+
+        return begin() + i;
+    }
+
+    iterator
+    erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    /**
+     * @brief Removes the elements in [first, last)
+     *
+     * The gap is moved to %first and then widened over the erased elements.
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        const size_type i = first.index();
+        const size_type k = last - first;
+
+        move_gap(i);
+        _destroy(_gap_end, _gap_end + k);
+        _gap_end += k;
+
+        return begin() + i;
+    }
+
+private:
+    // See vector::_relocatable.
+    static constexpr bool _relocatable =
+        is_trivially_relocatable_v<Tp> && __alloc_constructs_plainly<Alloc, Tp>;
+
+    allocator_type _alloc;
+    pointer _start;
+    pointer _gap_start;
+    pointer _gap_end;
+    pointer _end;
+
+    static void
+    _relocate(pointer first, pointer last, pointer result) noexcept
+    {
+        if (first != last)
+            std::memmove(static_cast<void *>(result),
+                         static_cast<const void *>(first),
+                         (last - first) * sizeof(value_type));
+    }
+
+    /**
+     * @brief Destroys the elements and frees the buffer
+     */
+    void
+    _release() noexcept
+    {
+        clear();
+
+        if (_start)
+            traits_t::deallocate(_alloc, _start, capacity());
+
+        _start     = pointer();
+        _gap_start = pointer();
+        _gap_end   = pointer();
+        _end       = pointer();
+    }
+
+    /**
+     * @brief Takes over the buffer of %other, leaving it empty
+     */
+    void
+    _steal(gap_vector &other) noexcept
+    {
+        _start     = other._start;
+        _gap_start = other._gap_start;
+        _gap_end   = other._gap_end;
+        _end       = other._end;
+
+        other._start     = pointer();
+        other._gap_start = pointer();
+        other._gap_end   = pointer();
+        other._end       = pointer();
+    }
+
+    /**
+     * @brief Replaces the contents with the %n elements from %first
+     *
+     * Existing elements are assigned in place, wherever the gap is. The
+     * missing ones are appended at the back.
+     */
+    template <typename ForwardIter>
+    void
+    _assign_n(ForwardIter first, size_type n)
+    {
+        const size_type common = std::min(n, size());
+
+        for (size_type i = 0; i < common; ++i, ++first)
+            *_slot(i) = *first;
+
+        if (n < size())
+            erase(cbegin() + n, cend());
+        else
+        {
+            reserve(n);
+            move_gap(size());
+
+            while (size() < n)
+            {
+                _append(*first);
+                ++first;
+            }
+        }
+    }
+
+    pointer
+    _slot(size_type pos) const noexcept
+    {
+        pointer p = _start + pos;
+        return p < _gap_start ? p : p + (_gap_end - _gap_start);
+    }
+
+    void
+    _destroy(pointer first, pointer last) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<value_type>::value)
+        {
+            for (; first != last; ++first)
+                traits_t::destroy(_alloc, first);
+        }
+    }
+
+    /**
+     * @brief Moves the element at %from to the free slot %to, the other end
+     * of the gap, and shifts the gap by one
+     */
+    void
+    _cross(pointer from, pointer to)
+    {
+        traits_t::construct(_alloc, to, std::move(*from));
+        traits_t::destroy(_alloc, from);
+
+        if (from < _gap_start)
+        {
+            --_gap_start;
+            --_gap_end;
+        }
+        else
+        {
+            ++_gap_start;
+            ++_gap_end;
+        }
+    }
+
+    template <typename Arg>
+    void
+    _append(Arg &&arg)
+    {
+        if (_gap_start == _gap_end)
+            _realloc_emplace(gap_position(), std::forward<Arg>(arg));
+        else
+        {
+            traits_t::construct(_alloc, _gap_start, std::forward<Arg>(arg));
+            ++_gap_start;
+        }
+    }
+
+    size_type
+    _check_len(size_type n, const char *s) const
+    {
+        if (max_size() - size() < n)
+            std::__throw_length_error(s);
+
+        return Growth::template next_capacity<value_type>(
+            capacity(), size() + n, max_size());
+    }
+
+    /**
+     * @brief Relocates the elements with index in [first, last) to %result
+     */
+    void
+    _relocate_range(size_type first, size_type last, pointer result) noexcept
+    {
+        const size_type gap = gap_position();
+
+        if (first < gap)
+        {
+            const size_type mid = std::min(last, gap);
+            _relocate(_start + first, _start + mid, result);
+            result += mid - first;
+            first   = mid;
+        }
+
+        if (first < last)
+            _relocate(_slot(first), _slot(first) + (last - first), result);
+    }
+
+    /**
+     * @brief Moves the elements into a new buffer of %new_len elements,
+     * with the gap in front of the element at %pos
+     *
+     * If %filled is true, the caller has already constructed a new element
+     * at %new_start + %pos, which ends up first in the gap's place. If a move
+     * constructor throws, the new buffer is left as the caller gave it and
+     * this gap_vector is unchanged.
+     */
+    void
+    _adopt(pointer new_start, size_type new_len, size_type pos, bool filled)
+    {
+        const size_type n   = size();
+        pointer new_gap_end = new_start + new_len - (n - pos);
+
+        if constexpr (_relocatable)
+        {
+            _relocate_range(0, pos, new_start);
+            _relocate_range(pos, n, new_gap_end);
+        }
+        else
+        {
+            auto dest = [&](size_type i) {
+                return i < pos ? new_start + i : new_gap_end + (i - pos);
+            };
+
+            size_type i = 0;
+
+            try
+            {
+                for (; i < n; ++i)
+                    traits_t::construct(_alloc, dest(i), std::move(*_slot(i)));
+            }
+            catch (...)
+            {
+                for (size_type j = 0; j < i; ++j)
+                    traits_t::destroy(_alloc, dest(j));
+                throw;
+            }
+
+            _destroy(_start, _gap_start);
+            _destroy(_gap_end, _end);
+        }
+
+        if (_start)
+            traits_t::deallocate(_alloc, _start, capacity());
+
+        _start     = new_start;
+        _gap_start = new_start + pos + filled;
+        _gap_end   = new_gap_end;
+        _end       = new_start + new_len;
+    }
+
+    void
+    _reallocate(size_type new_len)
+    {
+        _reallocate(new_len, gap_position());
+    }
+
+    void
+    _reallocate(size_type new_len, size_type pos)
+    {
+        pointer new_start = new_len ? traits_t::allocate(_alloc, new_len)
+                                    : pointer();
+
+        try
+        {
+            _adopt(new_start, new_len, pos, false);
+        }
+        catch (...)
+        {
+            if (new_start)
+                traits_t::deallocate(_alloc, new_start, new_len);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Grows the buffer and constructs an element at %pos
+     *
+     * The new element is built before the others move, so %args may refer
+     * to one of them.
+     */
+    template <typename... Args>
+    void
+    _realloc_emplace(size_type pos, Args &&...args)
+    {
+        const size_type len = _check_len(1, "gap_vector::_realloc_emplace");
+        pointer new_start   = traits_t::allocate(_alloc, len);
+
+        try
+        {
+            traits_t::construct(_alloc, new_start + pos,
+                                std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            traits_t::deallocate(_alloc, new_start, len);
+            throw;
+        }
+
+        try
+        {
+            _adopt(new_start, len, pos, true);
+        }
+        catch (...)
+        {
+            traits_t::destroy(_alloc, new_start + pos);
+            traits_t::deallocate(_alloc, new_start, len);
+            throw;
+        }
+    }
+};
+
+template <typename Tp, typename Alloc, typename Growth>
+inline void
+swap(gap_vector<Tp, Alloc, Growth> &lhs,
+     gap_vector<Tp, Alloc, Growth> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+} // namespace dutcpp
+
+#endif
@@ -0,0 +1,806 @@
+/**
+ * @file incremental_vector.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A vector that spreads the cost of growing over later operations
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef __DUTCPP_INCREMENTAL_VECTOR_H
+#define __DUTCPP_INCREMENTAL_VECTOR_H 1
+
+#include <algorithm>
+
+#include "mmap_storage.h"
+#include "vector.h"
+
+namespace dutcpp
+{
+/**
+ * @brief A vector whose reallocation is paid in bounded steps
+ *
+ * When vector runs out of room, the push_back() that notices moves every
+ * element to the new buffer, so one call in a long series takes O(size())
+ * time. incremental_vector instead keeps the old buffer alive next to the
+ * new one and moves at most %Step elements per later push_back(), from the
+ * top down:
+ *
+ *     _old                     _old + _pending
+ *      |                             |
+ *      v                             v
+ *      [ 0 | 1 | 2 | 3 | 4 | 5 | 6 | x | x | x ]
+ *
+ *     _start                   _start + _pending   _finish       _end
+ *      |                             |                |             |
+ *      v                             v                v             v
+ *      [ x | x | x | x | x | x | x | 7 | 8 | 9 | 10 | x | x | ... | x ]
+ *
+ * Element i lives in the old buffer if i < _pending and in the new one
+ * otherwise, so operator[] costs one extra comparison. With a growth factor
+ * of g, the buffer fills up again after (g - 1) * size() pushes, enough to
+ * move every element if %Step >= 1 / (g - 1). If not, the next growth first
+ * finishes the migration at once.
+ *
+ * Growing itself only allocates and constructs the new element. Pages of a
+ * large new buffer are touched, and faulted in, one step at a time as well.
+ * The elements are contiguous only when migrating() is false, so there is
+ * no data(); iterators go through operator[].
+ */
+template <typename Tp, typename Alloc = std::allocator<Tp>,
+          typename Growth = doubling_growth, std::size_t Step = 32>
+class incremental_vector
+{
+    static_assert(Step > 0, "incremental_vector needs a positive Step");
+
+public:
+    using value_type      = Tp;
+    using reference       = Tp &;
+    using const_reference = const Tp &;
+    using pointer         = Tp *;
+    using const_pointer   = const Tp *;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using allocator_type = Alloc;
+    using traits_t       = std::allocator_traits<allocator_type>;
+
+    static_assert(std::is_same<typename traits_t::pointer, Tp *>::value,
+                  "incremental_vector does not support fancy pointers");
+
+    using iterator               = __indexed_iterator<incremental_vector, false>;
+    using const_iterator         = __indexed_iterator<incremental_vector, true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Largest number of elements moved per push_back()
+     */
+    static constexpr size_type migration_step = Step;
+
+    incremental_vector() noexcept(noexcept(allocator_type()))
+    : incremental_vector(allocator_type())
+    {
+    }
+
+    explicit incremental_vector(const allocator_type &alloc) noexcept
+    : _alloc(alloc), _start(), _finish(), _end(), _old(), _old_cap(0),
+      _pending(0)
+    {
+    }
+
+    incremental_vector(size_type count, const_reference value,
+                       const allocator_type &alloc = allocator_type())
+    : incremental_vector(alloc)
+    {
+        reserve(count);
+        for (size_type i = 0; i < count; ++i)
+            emplace_back(value);
+    }
+
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    incremental_vector(InputIter first, InputIter last,
+                       const allocator_type &alloc = allocator_type())
+    : incremental_vector(alloc)
+    {
+        using category =
+            typename std::iterator_traits<InputIter>::iterator_category;
+
+        if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                      category>::value)
+            reserve(std::distance(first, last));
+
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    incremental_vector(std::initializer_list<value_type> init,
+                       const allocator_type &alloc = allocator_type())
+    : incremental_vector(init.begin(), init.end(), alloc)
+    {
+    }
+
+    incremental_vector(const incremental_vector &other)
+    : incremental_vector(
+          traits_t::select_on_container_copy_construction(other._alloc))
+    {
+        reserve(other.size());
+        for (size_type i = 0; i < other.size(); ++i)
+            emplace_back(other[i]);
+    }
+
+    incremental_vector(incremental_vector &&other) noexcept
+    : _alloc(std::move(other._alloc)), _start(), _finish(), _end(), _old(),
+      _old_cap(0), _pending(0)
+    {
+        _steal(other);
+    }
+
+    /**
+     * @brief Copy assignment
+     *
+     * The allocator of %other is copied over if
+     * propagate_on_container_copy_assignment is true, after the memory of
+     * the old one is released if the two are not equal. Existing elements are
+     * copy-assigned and the buffer is reused if it is large enough.
+     */
+    incremental_vector &
+    operator=(const incremental_vector &other)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_copy_assignment::value)
+        {
+            if (!traits_t::is_always_equal::value && _alloc != other._alloc)
+                _release();
+
+            _alloc = other._alloc;
+        }
+
+        _assign_n(other.begin(), other.size());
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment
+     *
+     * The buffers of %other, including one still being migrated from, are
+     * taken over if propagate_on_container_move_assignment is true or both
+     * allocators are equal. Otherwise, the elements are moved one by one
+     * into storage from the current allocator.
+     */
+    incremental_vector &
+    operator=(incremental_vector &&other) noexcept(
+        traits_t::propagate_on_container_move_assignment::value ||
+        traits_t::is_always_equal::value)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_move_assignment::value)
+        {
+            _release();
+            _alloc = std::move(other._alloc);
+            _steal(other);
+        }
+        else if (traits_t::is_always_equal::value || _alloc == other._alloc)
+        {
+            _release();
+            _steal(other);
+        }
+        else
+        {
+            _assign_n(std::make_move_iterator(other.begin()), other.size());
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    ~incremental_vector()
+    {
+        _release();
+    }
+
+    /**
+     * @brief Exchanges the contents of this incremental_vector with %other
+     *
+     * Allocators are swapped only if propagate_on_container_swap is true.
+     * Otherwise, they must compare equal.
+     */
+    void
+    swap(incremental_vector &other) noexcept
+    {
+        if constexpr (traits_t::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(_alloc, other._alloc);
+        }
+
+        std::swap(_start, other._start);
+        std::swap(_finish, other._finish);
+        std::swap(_end, other._end);
+        std::swap(_old, other._old);
+        std::swap(_old_cap, other._old_cap);
+        std::swap(_pending, other._pending);
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _alloc;
+    }
+
+    iterator
+    begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    iterator
+    end() noexcept
+    {
+        return iterator(this, size());
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(this, size());
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return const_iterator(this, size());
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    const_reverse_iterator
+    crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    reference
+    operator[](size_type pos) noexcept
+    {
+        return *_slot(pos);
+    }
+
+    const_reference
+    operator[](size_type pos) const noexcept
+    {
+        return *_slot(pos);
+    }
+
+    reference
+    at(size_type pos)
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("incremental_vector::at");
+
+        return *_slot(pos);
+    }
+
+    const_reference
+    at(size_type pos) const
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("incremental_vector::at");
+
+        return *_slot(pos);
+    }
+
+    reference
+    front() noexcept
+    {
+        return *_slot(0);
+    }
+
+    const_reference
+    front() const noexcept
+    {
+        return *_slot(0);
+    }
+
+    reference
+    back() noexcept
+    {
+        return *_slot(size() - 1);
+    }
+
+    const_reference
+    back() const noexcept
+    {
+        return *_slot(size() - 1);
+    }
+
+    _GLIBCXX_NODISCARD bool
+    empty() const noexcept
+    {
+        return _finish == _start;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _finish - _start;
+    }
+
+    size_type
+    capacity() const noexcept
+    {
+        return _end - _start;
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return traits_t::max_size(_alloc);
+    }
+
+    /**
+     * @brief Checks if some elements are still in the previous buffer
+     */
+    bool
+    migrating() const noexcept
+    {
+        return _pending != 0;
+    }
+
+    /**
+     * @brief Returns the number of elements still in the previous buffer
+     */
+    size_type
+    migration_pending() const noexcept
+    {
+        return _pending;
+    }
+
+    /**
+     * @brief Moves up to %n more elements to the current buffer and returns
+     * how many are left
+     *
+     * Lets idle time make progress, so that the migration is done before
+     * the next growth needs it. If a move constructor throws, the elements
+     * moved so far stay moved and the container is otherwise unchanged.
+     */
+    size_type
+    migrate(size_type n = Step)
+    {
+        _migrate(n);
+        return _pending;
+    }
+
+    /**
+     * @brief Moves every remaining element to the current buffer
+     *
+     * O(migration_pending()). Afterwards the elements are contiguous.
+     */
+    void
+    finish_migration()
+    {
+        _migrate(_pending);
+    }
+
+    /**
+     * @brief Makes room for %n elements
+     *
+     * The elements move to the new buffer incrementally, like on growth. A
+     * migration that is still in flight is finished first.
+     */
+    void
+    reserve(size_type n)
+    {
+        if (n > max_size())
+            std::__throw_length_error("incremental_vector::reserve");
+
+        if (n <= capacity())
+            return;
+
+        pointer new_start = traits_t::allocate(_alloc, n);
+
+        try
+        {
+            finish_migration();
+        }
+        catch (...)
+        {
+            traits_t::deallocate(_alloc, new_start, n);
+            throw;
+        }
+
+        _begin_migration(new_start, n);
+    }
+
+    void
+    clear() noexcept
+    {
+        _destroy(_old, _old + _pending);
+        _destroy(_start + _pending, _finish);
+        _release_old();
+
+        _finish = _start;
+    }
+
+    void
+    push_back(const_reference value)
+    {
+        emplace_back(value);
+    }
+
+    void
+    push_back(value_type &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    /**
+     * @brief Constructs an element at the end
+     *
+     * O(Step). Grows with an allocation and no element moves, then the next
+     * calls move up to Step elements each. %args may refer to an element of
+     * this incremental_vector.
+     */
+    template <typename... Args>
+    reference
+    emplace_back(Args &&...args)
+    {
+        if (_finish == _end)
+            _realloc_emplace_back(std::forward<Args>(args)...);
+        else
+        {
+            traits_t::construct(_alloc, _finish, std::forward<Args>(args)...);
+            ++_finish;
+
+            // After the construction, as the step may move what %args
+            // refers to.
+            if (_pending)
+            {
+                try
+                {
+                    _migrate(Step);
+                }
+                catch (...)
+                {
+                    --_finish;
+                    traits_t::destroy(_alloc, _finish);
+                    throw;
+                }
+            }
+        }
+
+        return back();
+    }
+
+    void
+    pop_back() noexcept
+    {
+        --_finish;
+
+        if (size() < _pending)
+        {
+            _pending = size();
+            traits_t::destroy(_alloc, _old + _pending);
+
+            if (!_pending)
+                _release_old();
+        }
+        else
+            traits_t::destroy(_alloc, _finish);
+    }
+
+private:
+    // See vector::_relocatable.
+    static constexpr bool _relocatable =
+        is_trivially_relocatable_v<Tp> && __alloc_constructs_plainly<Alloc, Tp>;
+
+    // Pages of the previous buffer are discarded as they empty (see
+    // _discard_vacated()). Like vector::_mappable, this is limited to
+    // std::allocator: others may hand out shared or device memory, where
+    // dropping pages behind their back has other effects.
+    static constexpr bool _discardable =
+        discard_pages_supported &&
+        std::is_same<Alloc, std::allocator<Tp>>::value;
+
+    allocator_type _alloc;
+    pointer _start;
+    pointer _finish;
+    pointer _end;
+
+    // Previous buffer, its capacity, and the number of elements it still
+    // holds, which are the first _pending ones.
+    pointer _old;
+    size_type _old_cap;
+    size_type _pending;
+
+    pointer
+    _slot(size_type pos) const noexcept
+    {
+        return (pos < _pending ? _old : _start) + pos;
+    }
+
+    void
+    _destroy(pointer first, pointer last) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<value_type>::value)
+        {
+            for (; first != last; ++first)
+                traits_t::destroy(_alloc, first);
+        }
+    }
+
+    void
+    _release_old() noexcept
+    {
+        if (_old)
+            traits_t::deallocate(_alloc, _old, _old_cap);
+
+        _old     = pointer();
+        _old_cap = 0;
+        _pending = 0;
+    }
+
+    /**
+     * @brief Destroys every element and frees both buffers
+     */
+    void
+    _release() noexcept
+    {
+        clear();
+
+        if (_start)
+            traits_t::deallocate(_alloc, _start, capacity());
+
+        _start  = pointer();
+        _finish = pointer();
+        _end    = pointer();
+    }
+
+    /**
+     * @brief Takes over the buffers of %other, leaving it empty
+     */
+    void
+    _steal(incremental_vector &other) noexcept
+    {
+        _start   = other._start;
+        _finish  = other._finish;
+        _end     = other._end;
+        _old     = other._old;
+        _old_cap = other._old_cap;
+        _pending = other._pending;
+
+        other._start   = pointer();
+        other._finish  = pointer();
+        other._end     = pointer();
+        other._old     = pointer();
+        other._old_cap = 0;
+        other._pending = 0;
+    }
+
+    /**
+     * @brief Replaces the contents with the %n elements from %first
+     *
+     * Existing elements are assigned in place, in whichever buffer holds
+     * them. The missing ones are appended at the back.
+     */
+    template <typename ForwardIter>
+    void
+    _assign_n(ForwardIter first, size_type n)
+    {
+        const size_type common = std::min(n, size());
+
+        for (size_type i = 0; i < common; ++i, ++first)
+            *_slot(i) = *first;
+
+        while (size() > n)
+            pop_back();
+
+        reserve(n);
+
+        for (size_type i = common; i < n; ++i, ++first)
+            emplace_back(*first);
+    }
+
+    /**
+     * @brief Moves the last min(%n, _pending) elements of the previous
+     * buffer to the current one, and frees it once it is empty
+     */
+    void
+    _migrate(size_type n)
+    {
+        if (n > _pending)
+            n = _pending;
+
+        const size_type hi = _pending;
+
+        if constexpr (_relocatable)
+        {
+            if (n)
+                std::memcpy(static_cast<void *>(_start + _pending - n),
+                            static_cast<const void *>(_old + _pending - n),
+                            n * sizeof(value_type));
+
+            _pending -= n;
+        }
+        else
+        {
+            for (; n; --n)
+            {
+                const size_type i = _pending - 1;
+
+                traits_t::construct(_alloc, _start + i,
+                                    std::move_if_noexcept(_old[i]));
+                traits_t::destroy(_alloc, _old + i);
+                _pending = i;
+            }
+        }
+
+        if (!_pending)
+            _release_old();
+        else
+            _discard_vacated(hi);
+    }
+
+    /**
+     * @brief Discards the pages of the previous buffer emptied by a step
+     * that started with %hi elements pending
+     *
+     * Freeing a buffer costs time in proportion to its resident pages, a few
+     * milliseconds for 32 MiB. Handing them back one step at a time keeps
+     * the final deallocation cheap. Small buffers are left alone, as they
+     * come from the heap and are cheap to free.
+     */
+    void
+    _discard_vacated(size_type hi) noexcept
+    {
+        if constexpr (_discardable)
+        {
+            if (_old_cap * sizeof(value_type) < __mmap_granule)
+                return;
+
+            // Each step discards up to the page that holds old element %hi,
+            // which the previous one kept as it was still in use. That page
+            // may extend past the buffer only if the buffer ends in it.
+            char *last = reinterpret_cast<char *>(_old + hi);
+            char *end  = reinterpret_cast<char *>(_old + _old_cap);
+
+            last += std::min<std::size_t>(__system_page_size() - 1,
+                                          end - last);
+            __discard_pages(_old + _pending, last);
+        }
+    }
+
+    /**
+     * @brief Makes %new_start the current buffer, with every element still
+     * pending in the previous one
+     *
+     * Expects no migration in flight.
+     */
+    void
+    _begin_migration(pointer new_start, size_type new_len) noexcept
+    {
+        const size_type n = size();
+
+        _old     = _start;
+        _old_cap = capacity();
+        _pending = n;
+        _start   = new_start;
+        _finish  = new_start + n;
+        _end     = new_start + new_len;
+
+        if (!_pending)
+            _release_old();
+    }
+
+    size_type
+    _check_len(size_type n, const char *s) const
+    {
+        if (max_size() - size() < n)
+            std::__throw_length_error(s);
+
+        return Growth::template next_capacity<value_type>(
+            capacity(), size() + n, max_size());
+    }
+
+    /**
+     * @brief Switches to a larger buffer and constructs an element at its
+     * end
+     *
+     * The new element is built before anything moves, so %args may refer to
+     * an element. Only a migration still in flight, which means Step is too
+     * small for the growth factor, is finished here in one go.
+     */
+    template <typename... Args>
+    void
+    _realloc_emplace_back(Args &&...args)
+    {
+        const size_type n   = size();
+        const size_type len = _check_len(1, "incremental_vector::emplace_back");
+        pointer new_start   = traits_t::allocate(_alloc, len);
+
+        try
+        {
+            traits_t::construct(_alloc, new_start + n,
+                                std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            traits_t::deallocate(_alloc, new_start, len);
+            throw;
+        }
+
+        try
+        {
+            finish_migration();
+        }
+        catch (...)
+        {
+            traits_t::destroy(_alloc, new_start + n);
+            traits_t::deallocate(_alloc, new_start, len);
+            throw;
+        }
+
+        _begin_migration(new_start, len);
+        ++_finish;
+    }
+};
+
+template <typename Tp, typename Alloc, typename Growth, std::size_t Step>
+inline void
+swap(incremental_vector<Tp, Alloc, Growth, Step> &lhs,
+     incremental_vector<Tp, Alloc, Growth, Step> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+} // namespace dutcpp
+
+#endif
@@ -0,0 +1,207 @@
+/**
+ * @file mmap_storage.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Anonymous memory mappings that grow with mremap()
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Very large buffers of trivially relocatable elements are better served by
+ * the kernel directly. A mapping can be grown with mremap(), which moves page
+ * table entries instead of bytes, so the old and new buffers never coexist
+ * and nothing is copied. The mappings are also marked MADV_HUGEPAGE to cut
+ * TLB misses when scanning them.
+ *
+ * vector switches to these mappings on its own (see vector::_mapped()) once a
+ * buffer reaches DUTCPP_MMAP_THRESHOLD bytes, 32 MiB unless defined
+ * otherwise. Defining DUTCPP_MMAP_THRESHOLD to 0 turns the feature off. Only
+ * Linux provides mremap(); elsewhere every buffer comes from the allocator.
+ *
+ * __discard_pages() hands the pages of a buffer that is being emptied back to
+ * the kernel ahead of freeing it, see incremental_vector.
+ */
+
+#ifndef __DUTCPP_MMAP_STORAGE_H
+#define __DUTCPP_MMAP_STORAGE_H 1
+
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifndef DUTCPP_MMAP_THRESHOLD
+#define DUTCPP_MMAP_THRESHOLD (std::size_t(32) << 20)
+#endif
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+#define __DUTCPP_HAVE_MREMAP 1
+#endif
+
+#if defined(__linux__) && defined(MADV_DONTNEED)
+#define __DUTCPP_HAVE_DISCARD 1
+#endif
+
+namespace dutcpp
+{
+/**
+ * @brief Smallest buffer, in bytes, placed in its own mapping
+ */
+inline constexpr std::size_t mmap_threshold = DUTCPP_MMAP_THRESHOLD;
+
+/**
+ * @brief Whether the platform supports growing mappings with mremap()
+ */
+#ifdef __DUTCPP_HAVE_MREMAP
+inline constexpr bool mmap_growth_supported = mmap_threshold > 0;
+#else
+inline constexpr bool mmap_growth_supported = false;
+#endif
+
+/**
+ * @brief Granularity of mapping sizes, one transparent huge page
+ */
+inline constexpr std::size_t __mmap_granule = std::size_t(2) << 20;
+
+inline std::size_t
+__mmap_round(std::size_t bytes) noexcept
+{
+    return (bytes + __mmap_granule - 1) & ~(__mmap_granule - 1);
+}
+
+#ifdef __DUTCPP_HAVE_MREMAP
+
+/**
+ * @brief Maps at least %bytes of zeroed, private memory
+ *
+ * %bytes is rounded up to a whole number of huge pages and updated to the
+ * size of the mapping. Throws std::bad_alloc on failure.
+ */
+inline void *
+__mmap_allocate(std::size_t &bytes)
+{
+    bytes   = __mmap_round(bytes);
+    void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (p == MAP_FAILED)
+        throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+    // Only a hint, the mapping works the same if it is refused.
+    ::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+
+    return p;
+}
+
+/**
+ * @brief Resizes the mapping at %p from %old_bytes to at least %new_bytes
+ *
+ * The contents up to the smaller size are kept, but the mapping may move.
+ * %new_bytes is updated like in __mmap_allocate(). On failure, throws
+ * std::bad_alloc and leaves the mapping untouched.
+ */
+inline void *
+__mmap_reallocate(void *p, std::size_t old_bytes, std::size_t &new_bytes)
+{
+    new_bytes = __mmap_round(new_bytes);
+    void *q   = ::mremap(p, __mmap_round(old_bytes), new_bytes,
+                         MREMAP_MAYMOVE);
+
+    if (q == MAP_FAILED)
+        throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+    ::madvise(q, new_bytes, MADV_HUGEPAGE);
+#endif
+
+    return q;
+}
+
+inline void
+__mmap_deallocate(void *p, std::size_t bytes) noexcept
+{
+    ::munmap(p, __mmap_round(bytes));
+}
+
+#endif
+
+/**
+ * @brief Whether __discard_pages() gives memory back to the kernel
+ */
+#ifdef __DUTCPP_HAVE_DISCARD
+inline constexpr bool discard_pages_supported = true;
+#else
+inline constexpr bool discard_pages_supported = false;
+#endif
+
+/**
+ * @brief Returns the size of a memory page
+ */
+inline std::size_t
+__system_page_size() noexcept
+{
+#ifdef __DUTCPP_HAVE_DISCARD
+    static const std::size_t size = std::size_t(::sysconf(_SC_PAGESIZE));
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+/**
+ * @brief Returns the pages that lie entirely inside [first, last) to the
+ * kernel
+ *
+ * The range must not hold live objects. It stays allocated: touching it
+ * again faults in zeroed pages. Freeing a large populated buffer costs time
+ * proportional to its resident pages, so discarding it piece by piece while
+ * it empties spreads that cost out. Does nothing where unsupported.
+ */
+inline void
+__discard_pages(void *first, void *last) noexcept
+{
+#ifdef __DUTCPP_HAVE_DISCARD
+    const std::size_t mask = __system_page_size() - 1;
+    const std::size_t a =
+        (reinterpret_cast<std::size_t>(first) + mask) & ~mask;
+    const std::size_t b = reinterpret_cast<std::size_t>(last) & ~mask;
+
+    // Only a hint, the range stays usable if it is refused.
+    if (a < b)
+        ::madvise(reinterpret_cast<void *>(a), b - a, MADV_DONTNEED);
+#else
+    (void)first;
+    (void)last;
+#endif
+}
+
+#ifndef __DUTCPP_HAVE_MREMAP
+
+// Never called, mmap_growth_supported is false.
+
+inline void *
+__mmap_allocate(std::size_t &)
+{
+    throw std::bad_alloc();
+}
+
+inline void *
+__mmap_reallocate(void *, std::size_t, std::size_t &)
+{
+    throw std::bad_alloc();
+}
+
+inline void
+__mmap_deallocate(void *, std::size_t) noexcept
+{
+}
+
+#endif
+} // namespace dutcpp
+
+#endif
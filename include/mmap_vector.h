@@ -0,0 +1,584 @@
+/**
+ * @file mmap_vector.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A vector whose elements live in a memory-mapped file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * The file holds the raw elements back to back, with no header, so opening
+ * it costs one mmap() call. Pages are read in on first access instead of
+ * being parsed and copied up front. POSIX only.
+ */
+
+#ifndef __DUTCPP_MMAP_VECTOR_H
+#define __DUTCPP_MMAP_VECTOR_H 1
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mmap_storage.h"
+#include "vector.h"
+
+namespace dutcpp
+{
+enum class mmap_mode
+{
+    read_only, // Shared read-only mapping, the file is never modified
+    read_write // Shared writable mapping that can grow the file
+};
+
+/**
+ * @brief A contiguous array of trivially copyable elements backed by a file
+ *
+ * In read_only mode, the elements must not be modified through the
+ * non-const accessors, and any call that changes the size throws
+ * std::logic_error.
+ *
+ * In read_write mode, changes go straight to the page cache and reach the
+ * file when the kernel writes the pages back, or on sync(). Like vector, the
+ * mapping keeps spare capacity. The file is grown with it and cut back to
+ * size() * sizeof(Tp) bytes by close().
+ */
+template <typename Tp, typename Growth = doubling_growth>
+class mmap_vector
+{
+    static_assert(std::is_trivially_copyable<Tp>::value,
+                  "mmap_vector requires a trivially copyable type");
+
+public:
+    using value_type      = Tp;
+    using reference       = Tp &;
+    using const_reference = const Tp &;
+    using pointer         = Tp *;
+    using const_pointer   = const Tp *;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using iterator               = __normal_iterator<pointer, mmap_vector>;
+    using const_iterator         = __normal_iterator<const_pointer, mmap_vector>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Constructs a vector that is not attached to any file
+     */
+    mmap_vector() noexcept
+    : _fd(-1), _mode(mmap_mode::read_only), _start(), _finish(), _end()
+    {
+    }
+
+    /**
+     * @brief Maps the file at %path
+     *
+     * In read_write mode, the file is created if it does not exist. Throws
+     * std::system_error if the file cannot be opened or mapped, and
+     * std::length_error if its size is not a multiple of sizeof(Tp).
+     */
+    explicit mmap_vector(const char *path,
+                         mmap_mode mode = mmap_mode::read_only)
+    : mmap_vector()
+    {
+        open(path, mode);
+    }
+
+    mmap_vector(const mmap_vector &)            = delete;
+    mmap_vector &operator=(const mmap_vector &) = delete;
+
+    mmap_vector(mmap_vector &&other) noexcept : mmap_vector()
+    {
+        swap(other);
+    }
+
+    mmap_vector &
+    operator=(mmap_vector &&other) noexcept
+    {
+        mmap_vector(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~mmap_vector()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+            // The elements are already in the page cache, only the final
+            // truncation was lost.
+        }
+    }
+
+    void
+    swap(mmap_vector &other) noexcept
+    {
+        std::swap(_fd, other._fd);
+        std::swap(_mode, other._mode);
+        std::swap(_start, other._start);
+        std::swap(_finish, other._finish);
+        std::swap(_end, other._end);
+    }
+
+    /**
+     * @brief Maps the file at %path, closing the current one first
+     */
+    void
+    open(const char *path, mmap_mode mode = mmap_mode::read_only)
+    {
+        close();
+
+        const int flags =
+            (mode == mmap_mode::read_write) ? (O_RDWR | O_CREAT) : O_RDONLY;
+
+        const int fd = ::open(path, flags | O_CLOEXEC, 0644);
+        if (fd < 0)
+            __throw_errno("mmap_vector: open");
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            const int err = errno;
+            ::close(fd);
+            __throw_errno("mmap_vector: fstat", err);
+        }
+
+        const size_type bytes = st.st_size;
+        if (bytes % sizeof(value_type) != 0)
+        {
+            ::close(fd);
+            std::__throw_length_error(
+                "mmap_vector: file size is not a multiple of the element size");
+        }
+
+        _fd   = fd;
+        _mode = mode;
+
+        if (bytes > 0)
+        {
+            try
+            {
+                _start = _map(bytes);
+            }
+            catch (...)
+            {
+                ::close(fd);
+                _fd = -1;
+                throw;
+            }
+        }
+
+        _finish = _start + bytes / sizeof(value_type);
+        _end    = _finish;
+    }
+
+    /**
+     * @brief Unmaps the file and closes it
+     *
+     * In read_write mode, the file is truncated to size() elements first, so
+     * spare capacity does not persist.
+     */
+    void
+    close()
+    {
+        if (_fd < 0)
+            return;
+
+        const int fd          = _fd;
+        const size_type bytes = size() * sizeof(value_type);
+        const bool writable   = (_mode == mmap_mode::read_write);
+
+        _unmap();
+        _fd     = -1;
+        _start  = pointer();
+        _finish = pointer();
+        _end    = pointer();
+
+        const bool truncated = !writable || ::ftruncate(fd, bytes) == 0;
+        const int err        = errno;
+
+        ::close(fd);
+
+        if (!truncated)
+            __throw_errno("mmap_vector: ftruncate", err);
+    }
+
+    bool
+    is_open() const noexcept
+    {
+        return _fd >= 0;
+    }
+
+    mmap_mode
+    mode() const noexcept
+    {
+        return _mode;
+    }
+
+    /**
+     * @brief Writes modified pages back to the file
+     *
+     * Waits for the writes to complete unless %async is true. Does nothing
+     * in read_only mode.
+     */
+    void
+    sync(bool async = false)
+    {
+        if (_mode != mmap_mode::read_write || !_start)
+            return;
+
+        if (::msync(_start, capacity() * sizeof(value_type),
+                    async ? MS_ASYNC : MS_SYNC) != 0)
+            __throw_errno("mmap_vector: msync");
+    }
+
+    iterator
+    begin() noexcept
+    {
+        return iterator(_start);
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(_start);
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return const_iterator(_start);
+    }
+
+    iterator
+    end() noexcept
+    {
+        return iterator(_finish);
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(_finish);
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return const_iterator(_finish);
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    const_reverse_iterator
+    crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    reference
+    operator[](size_type pos) noexcept
+    {
+        return _start[pos];
+    }
+
+    const_reference
+    operator[](size_type pos) const noexcept
+    {
+        return _start[pos];
+    }
+
+    /**
+     * @brief Returns a reference to the element at %pos
+     *
+     * Throws std::out_of_range if %pos >= size().
+     */
+    reference
+    at(size_type pos)
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("mmap_vector::at");
+
+        return _start[pos];
+    }
+
+    const_reference
+    at(size_type pos) const
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("mmap_vector::at");
+
+        return _start[pos];
+    }
+
+    reference
+    front() noexcept
+    {
+        return *_start;
+    }
+
+    const_reference
+    front() const noexcept
+    {
+        return *_start;
+    }
+
+    reference
+    back() noexcept
+    {
+        return *(_finish - 1);
+    }
+
+    const_reference
+    back() const noexcept
+    {
+        return *(_finish - 1);
+    }
+
+    pointer
+    data() noexcept
+    {
+        return _start;
+    }
+
+    const_pointer
+    data() const noexcept
+    {
+        return _start;
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return _start == _finish;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _finish - _start;
+    }
+
+    size_type
+    capacity() const noexcept
+    {
+        return _end - _start;
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return std::numeric_limits<difference_type>::max() / sizeof(value_type);
+    }
+
+    /**
+     * @brief Grows the file and the mapping to hold at least %n elements
+     *
+     * Iterators are invalidated if the mapping moves.
+     */
+    void
+    reserve(size_type n)
+    {
+        _check_writable("mmap_vector::reserve");
+
+        if (n > max_size())
+            std::__throw_length_error("mmap_vector::reserve");
+
+        if (n > capacity())
+            _remap(n);
+    }
+
+    /**
+     * @brief Resizes to %count elements, new ones are copies of %value
+     */
+    void
+    resize(size_type count, const value_type &value = value_type())
+    {
+        _check_writable("mmap_vector::resize");
+
+        if (count > capacity())
+        {
+            // %value may live in the mapping
+            const value_type tmp = value;
+
+            _remap(_check_len(count - size(), "mmap_vector::resize"));
+            std::uninitialized_fill(_finish, _start + count, tmp);
+        }
+        else if (count > size())
+            std::uninitialized_fill(_finish, _start + count, value);
+
+        _finish = _start + count;
+    }
+
+    void
+    push_back(const value_type &value)
+    {
+        emplace_back(value);
+    }
+
+    template <typename... Args>
+    reference
+    emplace_back(Args &&...args)
+    {
+        _check_writable("mmap_vector::emplace_back");
+
+        if (_finish == _end)
+        {
+            // %args may refer to an element, and the mapping may move
+            value_type tmp(std::forward<Args>(args)...);
+
+            _remap(_check_len(1, "mmap_vector::emplace_back"));
+            ::new (static_cast<void *>(_finish)) value_type(tmp);
+        }
+        else
+            ::new (static_cast<void *>(_finish))
+                value_type(std::forward<Args>(args)...);
+
+        return *_finish++;
+    }
+
+    /**
+     * @brief Removes all elements, keeping the capacity
+     */
+    void
+    clear()
+    {
+        _check_writable("mmap_vector::clear");
+        _finish = _start;
+    }
+
+private:
+    [[noreturn]] static void
+    __throw_errno(const char *what, int err = errno)
+    {
+        throw std::system_error(err, std::generic_category(), what);
+    }
+
+    void
+    _check_writable(const char *s) const
+    {
+        if (_mode != mmap_mode::read_write)
+            std::__throw_logic_error(s);
+    }
+
+    size_type
+    _check_len(size_type n, const char *s) const
+    {
+        if (max_size() - size() < n)
+            std::__throw_length_error(s);
+
+        return Growth::template next_capacity<value_type>(
+            capacity(), size() + n, max_size());
+    }
+
+    pointer
+    _map(size_type bytes)
+    {
+        const int prot = (_mode == mmap_mode::read_write)
+                             ? (PROT_READ | PROT_WRITE)
+                             : PROT_READ;
+
+        void *p = ::mmap(nullptr, bytes, prot, MAP_SHARED, _fd, 0);
+        if (p == MAP_FAILED)
+            __throw_errno("mmap_vector: mmap");
+
+        return static_cast<pointer>(p);
+    }
+
+    void
+    _unmap() noexcept
+    {
+        if (_start)
+            ::munmap(_start, capacity() * sizeof(value_type));
+    }
+
+    /**
+     * @brief Grows the file to %new_len elements and maps all of it
+     *
+     * The file is extended first. If the mapping then fails, the vector is
+     * unchanged apart from the larger file, which close() cuts back.
+     */
+    void
+    _remap(size_type new_len)
+    {
+        const size_type n     = size();
+        const size_type bytes = new_len * sizeof(value_type);
+
+        if (::ftruncate(_fd, bytes) != 0)
+            __throw_errno("mmap_vector: ftruncate");
+
+        pointer p;
+
+        if (!_start)
+            p = _map(bytes);
+        else
+        {
+#ifdef __DUTCPP_HAVE_MREMAP
+            void *q = ::mremap(_start, capacity() * sizeof(value_type), bytes,
+                               MREMAP_MAYMOVE);
+            if (q == MAP_FAILED)
+                __throw_errno("mmap_vector: mremap");
+
+            p = static_cast<pointer>(q);
+#else
+            // The contents are in the file, a new mapping sees them as well.
+            p = _map(bytes);
+            _unmap();
+#endif
+        }
+
+        _start  = p;
+        _finish = p + n;
+        _end    = p + new_len;
+    }
+
+    int _fd;
+    mmap_mode _mode;
+    pointer _start;
+    pointer _finish;
+    pointer _end;
+};
+
+template <typename Tp, typename Growth>
+inline void
+swap(mmap_vector<Tp, Growth> &lhs, mmap_vector<Tp, Growth> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+} // namespace dutcpp
+
+#endif
@@ -0,0 +1,359 @@
+/**
+ * @file parallel.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A small thread pool and parallel loops over contiguous ranges
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Passing dutcpp::par as the first argument of a vector constructor builds
+ * the elements on every core. The same machinery is available for existing
+ * ranges through parallel_for_each() and parallel_transform().
+ *
+ * Work is split into contiguous chunks that start on a page boundary, so
+ * with a lazily committed buffer (e.g. a large malloc() served by mmap())
+ * every page is first touched, and therefore placed on the NUMA node of, the
+ * thread that constructs the elements in it.
+ */
+
+#ifndef __DUTCPP_PARALLEL_H
+#define __DUTCPP_PARALLEL_H 1
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dutcpp
+{
+/**
+ * @brief Execution policy tag requesting parallel execution
+ */
+struct parallel_policy
+{
+    explicit parallel_policy() = default;
+};
+
+inline constexpr parallel_policy par{};
+
+/**
+ * @brief A fixed set of worker threads that run indexed tasks
+ *
+ * run() is a fork-join call: it hands out task indices to the workers and to
+ * the calling thread, and returns once every task is done. Calls made from
+ * inside a task run serially on the current thread, so nested parallel loops
+ * never deadlock.
+ */
+class thread_pool
+{
+public:
+    /**
+     * @brief Returns the process-wide pool
+     *
+     * It has one worker less than std::thread::hardware_concurrency(), since
+     * the caller of run() takes part as well. Like vector_stats_registry, the
+     * pool is never destroyed.
+     */
+    static thread_pool &
+    instance()
+    {
+        static thread_pool *pool = new thread_pool(
+            std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return *pool;
+    }
+
+    /**
+     * @brief Starts %workers threads
+     */
+    explicit thread_pool(std::size_t workers)
+    : _task(nullptr), _context(nullptr), _tasks(0), _next(0), _busy(0),
+      _generation(0), _stop(false)
+    {
+        _threads.reserve(workers);
+
+        try
+        {
+            for (std::size_t i = 0; i < workers; ++i)
+                _threads.emplace_back([this] { _work(); });
+        }
+        catch (...)
+        {
+            _join();
+            throw;
+        }
+    }
+
+    thread_pool(const thread_pool &)            = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    ~thread_pool()
+    {
+        _join();
+    }
+
+    /**
+     * @brief Returns the number of threads that run tasks, caller included
+     */
+    std::size_t
+    concurrency() const noexcept
+    {
+        return _threads.size() + 1;
+    }
+
+    /**
+     * @brief Calls %fn(i) for every i in [0, %tasks) and waits for all of them
+     *
+     * If a task throws, the tasks that have not started yet are skipped and
+     * the first exception is rethrown here once the running ones are done.
+     */
+    template <typename Fn>
+    void
+    run(std::size_t tasks, Fn &&fn)
+    {
+        if (tasks == 0)
+            return;
+
+        if (tasks == 1 || _threads.empty() || __inside_task())
+        {
+            for (std::size_t i = 0; i < tasks; ++i)
+                fn(i);
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit(_submit);
+
+        using Fp = std::remove_reference_t<Fn>;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _task = [](void *context, std::size_t i) {
+                (*static_cast<Fp *>(context))(i);
+            };
+            _context = const_cast<void *>(
+                static_cast<const void *>(std::addressof(fn)));
+            _tasks = tasks;
+            _next.store(0, std::memory_order_relaxed);
+            _busy  = _threads.size();
+            _error = nullptr;
+            ++_generation;
+        }
+        _wake.notify_all();
+
+        _drain();
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _busy == 0; });
+
+        if (_error)
+            std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+
+private:
+    using task_t = void (*)(void *, std::size_t);
+
+    static bool &
+    __inside_task() noexcept
+    {
+        static thread_local bool inside = false;
+        return inside;
+    }
+
+    /**
+     * @brief Runs tasks of the current job until none is left
+     */
+    void
+    _drain() noexcept
+    {
+        __inside_task() = true;
+
+        for (;;)
+        {
+            const std::size_t i = _next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= _tasks)
+                break;
+
+            try
+            {
+                _task(_context, i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_error)
+                    _error = std::current_exception();
+
+                _next.store(_tasks, std::memory_order_relaxed);
+            }
+        }
+
+        __inside_task() = false;
+    }
+
+    void
+    _work()
+    {
+        std::uint64_t seen = 0;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock,
+                           [&] { return _stop || _generation != seen; });
+
+                if (_stop)
+                    return;
+
+                seen = _generation;
+            }
+
+            _drain();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (--_busy > 0)
+                    continue;
+            }
+            _done.notify_one();
+        }
+    }
+
+    void
+    _join() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+
+        for (auto &t : _threads)
+            t.join();
+        _threads.clear();
+    }
+
+    std::vector<std::thread> _threads;
+
+    std::mutex _submit; // One job at a time
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+
+    task_t _task;
+    void *_context;
+    std::size_t _tasks;
+    std::atomic<std::size_t> _next;
+    std::size_t _busy; // Workers still in the current job
+    std::uint64_t _generation;
+    std::exception_ptr _error;
+    bool _stop;
+};
+
+/**
+ * @brief Smallest amount of work, in bytes of elements, worth a task
+ */
+inline constexpr std::size_t __parallel_min_chunk_bytes = std::size_t(1) << 20;
+
+inline constexpr std::size_t __page_size = 4096;
+
+/**
+ * @brief Splits [0, %count) into chunks for thread_pool::run
+ *
+ * Chunks start on page boundaries (given an aligned base) and are large
+ * enough to amortize scheduling. There are a few per thread so that uneven
+ * progress evens out.
+ */
+struct __parallel_split
+{
+    std::size_t chunks;
+    std::size_t step;
+
+    __parallel_split(std::size_t count, std::size_t elem_size,
+                     std::size_t concurrency) noexcept
+    {
+        const std::size_t bytes = count * elem_size;
+        const std::size_t page =
+            std::max<std::size_t>(1, __page_size / elem_size);
+        const std::size_t n = std::clamp<std::size_t>(
+            bytes / __parallel_min_chunk_bytes, 1, 4 * concurrency);
+
+        step   = (count + n - 1) / n;
+        step   = (step + page - 1) / page * page;
+        chunks = step ? (count + step - 1) / step : 0;
+    }
+
+    std::size_t
+    first(std::size_t chunk) const noexcept
+    {
+        return chunk * step;
+    }
+
+    std::size_t
+    last(std::size_t chunk, std::size_t count) const noexcept
+    {
+        return std::min(count, (chunk + 1) * step);
+    }
+};
+
+/**
+ * @brief Calls %fn on every element of [first, last) in parallel
+ *
+ * Elements are visited in unspecified order. If %fn throws, some elements
+ * may not have been visited and the first exception is rethrown.
+ */
+template <class RandomIter, class Fn>
+void
+parallel_for_each(RandomIter first, RandomIter last, Fn fn)
+{
+    using value_type = typename std::iterator_traits<RandomIter>::value_type;
+
+    const std::size_t count = std::distance(first, last);
+    thread_pool &pool       = thread_pool::instance();
+    const __parallel_split split(count, sizeof(value_type), pool.concurrency());
+
+    pool.run(split.chunks, [&](std::size_t c) {
+        const RandomIter end = first + split.last(c, count);
+
+        for (RandomIter it = first + split.first(c); it != end; ++it)
+            fn(*it);
+    });
+}
+
+/**
+ * @brief Writes %fn(x) for every x of [first, last) to %out in parallel
+ *
+ * %out must be a random-access iterator to at least last - first assignable
+ * elements. Returns the end of the written range.
+ */
+template <class RandomIter, class RandomOutIter, class Fn>
+RandomOutIter
+parallel_transform(RandomIter first, RandomIter last, RandomOutIter out,
+                   Fn fn)
+{
+    using value_type = typename std::iterator_traits<RandomIter>::value_type;
+
+    const std::size_t count = std::distance(first, last);
+    thread_pool &pool       = thread_pool::instance();
+    const __parallel_split split(count, sizeof(value_type), pool.concurrency());
+
+    pool.run(split.chunks, [&](std::size_t c) {
+        const std::size_t end = split.last(c, count);
+
+        for (std::size_t i = split.first(c); i < end; ++i)
+            out[i] = fn(first[i]);
+    });
+
+    return out + count;
+}
+} // namespace dutcpp
+
+#endif
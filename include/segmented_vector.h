@@ -0,0 +1,891 @@
+/**
+ * @file segmented_vector.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A vector made of fixed-size blocks that never relocates elements
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef __DUTCPP_SEGMENTED_VECTOR_H
+#define __DUTCPP_SEGMENTED_VECTOR_H 1
+
+#include <span>
+
+#include "vector.h"
+
+namespace dutcpp
+{
+/**
+ * @brief Default number of elements per block, about 4 KiB worth
+ */
+template <typename Tp>
+inline constexpr std::size_t __segment_default_block =
+    sizeof(Tp) <= 256 ? 4096 / sizeof(Tp) : 16;
+
+/**
+ * @brief Position inside a segmented_vector, used as the base of its
+ * __normal_iterator
+ *
+ * Holds a pointer to the current element and one to the block index entry
+ * of the block that contains it. The index is terminated by a null entry, so
+ * the position one-past a full last block is { nullptr, &terminator } and
+ * stepping onto it needs no special case.
+ */
+template <typename Tp, std::size_t BlockSize>
+class __segment_pointer
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename std::remove_const<Tp>::type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Tp *;
+    using reference         = Tp &;
+
+    constexpr __segment_pointer() noexcept : _cur(nullptr), _node(nullptr) { }
+
+    __segment_pointer(Tp *cur, Tp *const *node) noexcept
+    : _cur(cur), _node(node)
+    {
+    }
+
+    template <typename Up,
+              typename = typename std::enable_if<
+                  std::is_convertible<Up *, Tp *>::value>::type>
+    __segment_pointer(const __segment_pointer<Up, BlockSize> &other) noexcept
+    : _cur(other._cur), _node(other._node)
+    {
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return *_cur;
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return _cur;
+    }
+
+    reference
+    operator[](difference_type n) const noexcept
+    {
+        return *(*this + n);
+    }
+
+    __segment_pointer &
+    operator++() noexcept
+    {
+        if (++_cur == *_node + BlockSize)
+            _cur = *++_node;
+
+        return *this;
+    }
+
+    __segment_pointer
+    operator++(int) noexcept
+    {
+        __segment_pointer tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    __segment_pointer &
+    operator--() noexcept
+    {
+        if (_cur == *_node)
+            _cur = *--_node + BlockSize;
+
+        --_cur;
+        return *this;
+    }
+
+    __segment_pointer
+    operator--(int) noexcept
+    {
+        __segment_pointer tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    __segment_pointer &
+    operator+=(difference_type n) noexcept
+    {
+        const difference_type block  = difference_type(BlockSize);
+        const difference_type offset = (_cur - *_node) + n;
+
+        if (offset >= 0 && offset < block)
+        {
+            _cur += n;
+            return *this;
+        }
+
+        const difference_type nodes =
+            offset >= 0 ? offset / block : -((-offset - 1) / block) - 1;
+
+        _node += nodes;
+        _cur   = *_node + (offset - nodes * block);
+        return *this;
+    }
+
+    __segment_pointer &
+    operator-=(difference_type n) noexcept
+    {
+        return *this += -n;
+    }
+
+    __segment_pointer
+    operator+(difference_type n) const noexcept
+    {
+        __segment_pointer tmp = *this;
+        return tmp += n;
+    }
+
+    __segment_pointer
+    operator-(difference_type n) const noexcept
+    {
+        __segment_pointer tmp = *this;
+        return tmp += -n;
+    }
+
+    friend difference_type
+    operator-(const __segment_pointer &lhs,
+              const __segment_pointer &rhs) noexcept
+    {
+        return (lhs._node - rhs._node) * difference_type(BlockSize) +
+               (lhs._cur - *lhs._node) - (rhs._cur - *rhs._node);
+    }
+
+    // Element addresses are unique, so equality only looks at %_cur.
+    friend bool
+    operator==(const __segment_pointer &lhs,
+               const __segment_pointer &rhs) noexcept
+    {
+        return lhs._cur == rhs._cur;
+    }
+
+    friend bool
+    operator!=(const __segment_pointer &lhs,
+               const __segment_pointer &rhs) noexcept
+    {
+        return lhs._cur != rhs._cur;
+    }
+
+    friend bool
+    operator<(const __segment_pointer &lhs,
+              const __segment_pointer &rhs) noexcept
+    {
+        return lhs._node == rhs._node ? lhs._cur < rhs._cur
+                                      : lhs._node < rhs._node;
+    }
+
+    friend bool
+    operator>(const __segment_pointer &lhs,
+              const __segment_pointer &rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+
+    friend bool
+    operator<=(const __segment_pointer &lhs,
+               const __segment_pointer &rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+
+    friend bool
+    operator>=(const __segment_pointer &lhs,
+               const __segment_pointer &rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+
+private:
+    template <typename, std::size_t>
+    friend class __segment_pointer;
+
+    Tp *_cur;
+    Tp *const *_node;
+};
+
+/**
+ * @brief A vector stored as fixed-size blocks behind a block index
+ *
+ * Elements are never relocated: when the last block is full, a new block of
+ * %BlockSize elements is allocated and its address appended to the index.
+ * push_back() is O(1) in the worst case apart from the index, which holds one
+ * pointer per block and so copies %BlockSize times less than a vector does
+ * when it grows.
+ *
+ *     index    [ * ][ * ][ * ][ 0 ]
+ *               |    |    |
+ *               v    v    v
+ *             [0..B) [B..2B) [2B..size)   (spare)
+ *
+ * References and pointers stay valid across push_back(), emplace_back() and
+ * reserve(). Iterators are invalidated when a block is added, since they
+ * point into the index.
+ *
+ * Each block is contiguous, so loops that need contiguous memory (the
+ * algorithms in simd_algorithm.h, memcpy, ...) can run block by block through
+ * block() or for_each_block().
+ */
+template <typename Tp, std::size_t BlockSize = __segment_default_block<Tp>,
+          typename Alloc = std::allocator<Tp>>
+class segmented_vector
+{
+    static_assert(BlockSize > 0, "segmented_vector needs non-empty blocks");
+
+public:
+    using value_type      = Tp;
+    using reference       = Tp &;
+    using const_reference = const Tp &;
+    using pointer         = Tp *;
+    using const_pointer   = const Tp *;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using allocator_type = Alloc;
+    using traits_t       = std::allocator_traits<allocator_type>;
+
+    using iterator =
+        __normal_iterator<__segment_pointer<Tp, BlockSize>, segmented_vector>;
+    using const_iterator =
+        __normal_iterator<__segment_pointer<const Tp, BlockSize>,
+                          segmented_vector>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type block_size = BlockSize;
+
+    segmented_vector() noexcept(noexcept(allocator_type()))
+    : segmented_vector(allocator_type())
+    {
+    }
+
+    explicit segmented_vector(const allocator_type &alloc) noexcept
+    : _alloc(alloc), _index(index_allocator(alloc)), _size(0)
+    {
+    }
+
+    explicit segmented_vector(size_type count,
+                              const allocator_type &alloc = allocator_type())
+    : segmented_vector(alloc)
+    {
+        resize(count);
+    }
+
+    segmented_vector(size_type count, const value_type &value,
+                     const allocator_type &alloc = allocator_type())
+    : segmented_vector(alloc)
+    {
+        resize(count, value);
+    }
+
+    template <typename InputIter,
+              typename = typename std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    segmented_vector(InputIter first, InputIter last,
+                     const allocator_type &alloc = allocator_type())
+    : segmented_vector(alloc)
+    {
+        _append_range(first, last);
+    }
+
+    segmented_vector(std::initializer_list<value_type> list,
+                     const allocator_type &alloc = allocator_type())
+    : segmented_vector(list.begin(), list.end(), alloc)
+    {
+    }
+
+    segmented_vector(const segmented_vector &other)
+    : segmented_vector(
+          traits_t::select_on_container_copy_construction(other._alloc))
+    {
+        _append_range(other.begin(), other.end());
+    }
+
+    segmented_vector(segmented_vector &&other) noexcept
+    : _alloc(std::move(other._alloc)), _index(std::move(other._index)),
+      _size(other._size)
+    {
+        other._size = 0;
+    }
+
+    /**
+     * @brief Copy assignment
+     *
+     * The allocator of %other is copied over if
+     * propagate_on_container_copy_assignment is true, after the blocks of
+     * the old one are freed if the two are not equal. Existing elements are
+     * copy-assigned and the blocks are reused.
+     */
+    segmented_vector &
+    operator=(const segmented_vector &other)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_copy_assignment::value)
+        {
+            if (!traits_t::is_always_equal::value && _alloc != other._alloc)
+            {
+                clear();
+                _release_blocks(0);
+
+                // Copying an empty index hands its allocator over as well
+                const _index_type empty(index_allocator(other._alloc));
+                _index = empty;
+            }
+
+            _alloc = other._alloc;
+        }
+
+        _assign_n(other.begin(), other._size);
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment
+     *
+     * The blocks of %other are taken over if
+     * propagate_on_container_move_assignment is true or both allocators are
+     * equal. Otherwise, the elements are moved one by one into blocks from
+     * the current allocator.
+     */
+    segmented_vector &
+    operator=(segmented_vector &&other) noexcept(
+        traits_t::propagate_on_container_move_assignment::value ||
+        traits_t::is_always_equal::value)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_move_assignment::value)
+        {
+            clear();
+            _release_blocks(0);
+            _alloc = std::move(other._alloc);
+            _take(other);
+        }
+        else if (traits_t::is_always_equal::value || _alloc == other._alloc)
+        {
+            clear();
+            _release_blocks(0);
+            _take(other);
+        }
+        else
+        {
+            _assign_n(std::make_move_iterator(other.begin()), other._size);
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    ~segmented_vector()
+    {
+        clear();
+        _release_blocks(0);
+    }
+
+    /**
+     * @brief Exchanges the contents of this segmented_vector with %other
+     *
+     * Allocators are swapped only if propagate_on_container_swap is true.
+     * Otherwise, they must compare equal.
+     */
+    void
+    swap(segmented_vector &other) noexcept
+    {
+        if constexpr (traits_t::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(_alloc, other._alloc);
+        }
+
+        _index.swap(other._index);
+        std::swap(_size, other._size);
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _alloc;
+    }
+
+    void
+    push_back(const value_type &value)
+    {
+        emplace_back(value);
+    }
+
+    void
+    push_back(value_type &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    /**
+     * @brief Constructs an element at the end
+     *
+     * %args may refer to an element of this vector: blocks never move, so it
+     * stays valid while a new block is added.
+     */
+    template <typename... Args>
+    reference
+    emplace_back(Args &&...args)
+    {
+        if (_size == capacity())
+            _add_block();
+
+        pointer p = _slot(_size);
+        traits_t::construct(_alloc, p, std::forward<Args>(args)...);
+        ++_size;
+
+        return *p;
+    }
+
+    void
+    pop_back() noexcept
+    {
+        --_size;
+        traits_t::destroy(_alloc, _slot(_size));
+    }
+
+    /**
+     * @brief Destroys all elements, keeping the blocks for reuse
+     */
+    void
+    clear() noexcept
+    {
+        _destroy_from(0);
+    }
+
+    /**
+     * @brief Allocates blocks until %n elements fit
+     */
+    void
+    reserve(size_type n)
+    {
+        if (n > max_size())
+            std::__throw_length_error("segmented_vector::reserve");
+
+        const size_type blocks = (n + BlockSize - 1) / BlockSize;
+
+        if (blocks > _block_capacity())
+            _index.reserve(blocks + 1);
+
+        while (_block_capacity() < blocks)
+            _add_block();
+    }
+
+    /**
+     * @brief Frees the blocks that hold no element
+     */
+    void
+    shrink_to_fit()
+    {
+        _release_blocks((_size + BlockSize - 1) / BlockSize);
+        _index.shrink_to_fit();
+    }
+
+    void
+    resize(size_type count)
+    {
+        if (count < _size)
+            _destroy_from(count);
+
+        reserve(count);
+
+        while (_size < count)
+            emplace_back();
+    }
+
+    void
+    resize(size_type count, const value_type &value)
+    {
+        if (count < _size)
+            _destroy_from(count);
+
+        reserve(count);
+
+        while (_size < count)
+            emplace_back(value);
+    }
+
+    reference
+    operator[](size_type pos) noexcept
+    {
+        return *_slot(pos);
+    }
+
+    const_reference
+    operator[](size_type pos) const noexcept
+    {
+        return *_slot(pos);
+    }
+
+    reference
+    at(size_type pos)
+    {
+        if (pos >= _size)
+            std::__throw_out_of_range("segmented_vector::at");
+
+        return *_slot(pos);
+    }
+
+    const_reference
+    at(size_type pos) const
+    {
+        if (pos >= _size)
+            std::__throw_out_of_range("segmented_vector::at");
+
+        return *_slot(pos);
+    }
+
+    reference
+    front() noexcept
+    {
+        return *_slot(0);
+    }
+
+    const_reference
+    front() const noexcept
+    {
+        return *_slot(0);
+    }
+
+    reference
+    back() noexcept
+    {
+        return *_slot(_size - 1);
+    }
+
+    const_reference
+    back() const noexcept
+    {
+        return *_slot(_size - 1);
+    }
+
+    /**
+     * @brief Returns the number of blocks that hold elements
+     */
+    size_type
+    block_count() const noexcept
+    {
+        return (_size + BlockSize - 1) / BlockSize;
+    }
+
+    /**
+     * @brief Returns the elements of block %k as a contiguous span
+     *
+     * Every block but the last one holds exactly %block_size elements.
+     */
+    std::span<value_type>
+    block(size_type k) noexcept
+    {
+        return std::span<value_type>(_index[k], _block_length(k));
+    }
+
+    std::span<const value_type>
+    block(size_type k) const noexcept
+    {
+        return std::span<const value_type>(_index[k], _block_length(k));
+    }
+
+    /**
+     * @brief Calls %fn with the span of each block, in order
+     */
+    template <typename Fn>
+    void
+    for_each_block(Fn fn)
+    {
+        const size_type n = block_count();
+        for (size_type k = 0; k < n; ++k)
+            fn(block(k));
+    }
+
+    template <typename Fn>
+    void
+    for_each_block(Fn fn) const
+    {
+        const size_type n = block_count();
+        for (size_type k = 0; k < n; ++k)
+            fn(block(k));
+    }
+
+    iterator
+    begin() noexcept
+    {
+        pointer *node = _node(0);
+        return iterator(typename iterator::iterator_type(*node, node));
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        pointer *node = _node(0);
+        return const_iterator(
+            typename const_iterator::iterator_type(*node, node));
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator
+    end() noexcept
+    {
+        pointer *node = _node(_size / BlockSize);
+        return iterator(typename iterator::iterator_type(
+            *node + _size % BlockSize, node));
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        pointer *node = _node(_size / BlockSize);
+        return const_iterator(typename const_iterator::iterator_type(
+            *node + _size % BlockSize, node));
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return end();
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    crend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _size;
+    }
+
+    size_type
+    capacity() const noexcept
+    {
+        return _block_capacity() * BlockSize;
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return std::min<size_type>(traits_t::max_size(_alloc),
+                                   std::numeric_limits<difference_type>::max() /
+                                       sizeof(value_type));
+    }
+
+private:
+    using index_allocator = typename traits_t::template rebind_alloc<pointer>;
+    using _index_type     = dutcpp::vector<pointer, index_allocator>;
+
+    // Index of an empty vector, so that begin() and end() need no branch.
+    inline static pointer _s_empty_index[1] = {nullptr};
+
+    /*
+     * The index lists the allocated blocks followed by a null terminator, or
+     * is empty when no block has been allocated yet.
+     */
+    size_type
+    _block_capacity() const noexcept
+    {
+        return _index.empty() ? 0 : _index.size() - 1;
+    }
+
+    size_type
+    _block_length(size_type k) const noexcept
+    {
+        return std::min(BlockSize, _size - k * BlockSize);
+    }
+
+    pointer *
+    _node(size_type k) const noexcept
+    {
+        return _index.empty() ? _s_empty_index
+                              : const_cast<pointer *>(_index.data()) + k;
+    }
+
+    pointer
+    _slot(size_type i) const noexcept
+    {
+        return _index[i / BlockSize] + i % BlockSize;
+    }
+
+    void
+    _add_block()
+    {
+        if (_block_capacity() >= max_size() / BlockSize)
+            std::__throw_length_error("segmented_vector");
+
+        pointer p = traits_t::allocate(_alloc, BlockSize);
+
+        try
+        {
+            if (_index.empty())
+                _index.push_back(nullptr);
+
+            _index.push_back(nullptr);
+        }
+        catch (...)
+        {
+            traits_t::deallocate(_alloc, p, BlockSize);
+            throw;
+        }
+
+        _index[_index.size() - 2] = p;
+    }
+
+    /**
+     * @brief Frees the blocks from %first on, which must hold no element
+     */
+    void
+    _release_blocks(size_type first) noexcept
+    {
+        const size_type n = _block_capacity();
+
+        if (first >= n)
+            return;
+
+        for (size_type k = first; k < n; ++k)
+            traits_t::deallocate(_alloc, _index[k], BlockSize);
+
+        if (first == 0)
+        {
+            _index.clear();
+        }
+        else
+        {
+            _index.resize(first + 1);
+            _index[first] = nullptr;
+        }
+    }
+
+    void
+    _destroy_from(size_type first) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<value_type>::value)
+        {
+            for (size_type i = first; i < _size; ++i)
+                traits_t::destroy(_alloc, _slot(i));
+        }
+
+        _size = first;
+    }
+
+    /**
+     * @brief Takes over the blocks of %other, which must come from an equal
+     * allocator. This vector must hold no block.
+     */
+    void
+    _take(segmented_vector &other) noexcept
+    {
+        _index      = std::move(other._index);
+        _size       = other._size;
+        other._size = 0;
+    }
+
+    /**
+     * @brief Replaces the contents with the %n elements from %first
+     *
+     * The first elements are assigned in place, and the blocks are reused.
+     */
+    template <typename InputIter>
+    void
+    _assign_n(InputIter first, size_type n)
+    {
+        const size_type common = std::min(n, _size);
+
+        for (size_type i = 0; i < common; ++i, ++first)
+            *_slot(i) = *first;
+
+        if (n < _size)
+            _destroy_from(n);
+        else
+        {
+            reserve(n);
+
+            for (; _size < n; ++first)
+                emplace_back(*first);
+        }
+    }
+
+    template <typename InputIter>
+    void
+    _append_range(InputIter first, InputIter last)
+    {
+        using category =
+            typename std::iterator_traits<InputIter>::iterator_category;
+
+        if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                      category>::value)
+            reserve(_size + size_type(std::distance(first, last)));
+
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    allocator_type _alloc;
+    _index_type _index;
+    size_type _size;
+};
+
+template <typename Tp, std::size_t BlockSize, typename Alloc>
+inline void
+swap(segmented_vector<Tp, BlockSize, Alloc> &lhs,
+     segmented_vector<Tp, BlockSize, Alloc> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+} // namespace dutcpp
+
+#endif
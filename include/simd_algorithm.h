@@ -0,0 +1,900 @@
+/**
+ * @file simd_algorithm.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Vectorized algorithms for contiguous arithmetic data
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * find, count, contains, min, max, sum, fill, equal, remove and remove_if
+ * over contiguous arrays of integers, float or double. Each kernel is written
+ * once with GCC vector extensions and compiled for SSE2 (16-byte), AVX2
+ * (32-byte) and AVX-512 (64-byte) vectors. The widest one the CPU supports is
+ * picked at runtime through CPUID. Other targets use the scalar loops.
+ *
+ * The functions in dutcpp::simd take std::span, so any contiguous storage
+ * works. The dutcpp:: overloads take a dutcpp::vector.
+ */
+
+#ifndef __DUTCPP_SIMD_ALGORITHM_H
+#define __DUTCPP_SIMD_ALGORITHM_H 1
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "vector.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+#define __DUTCPP_SIMD_X86 1
+#endif
+
+#define __DUTCPP_ALWAYS_INLINE inline __attribute__((always_inline))
+
+namespace dutcpp
+{
+/**
+ * @brief Element types the vectorized algorithms accept
+ */
+template <typename Tp>
+concept simd_arithmetic =
+    (std::is_integral_v<Tp> && !std::is_same_v<Tp, bool>) ||
+    std::is_same_v<Tp, float> || std::is_same_v<Tp, double>;
+
+/**
+ * @brief Result type of sum()
+ *
+ * Integers are summed in 64 bits so that sums over large int32 columns do
+ * not overflow. Floating-point values are summed in their own type.
+ */
+template <typename Tp>
+using simd_sum_t = std::conditional_t<
+    std::is_floating_point_v<Tp>, Tp,
+    std::conditional_t<std::is_signed_v<Tp>, std::int64_t, std::uint64_t>>;
+
+namespace simd
+{
+enum class level
+{
+    scalar,
+    sse2,
+    avx2,
+    avx512
+};
+
+/**
+ * @brief Returns the widest instruction set supported by this CPU
+ */
+inline level
+detected_level() noexcept
+{
+#ifdef __DUTCPP_SIMD_X86
+    static const level detected = [] {
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx512f") &&
+            __builtin_cpu_supports("avx512bw"))
+            return level::avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return level::avx2;
+        if (__builtin_cpu_supports("sse2"))
+            return level::sse2;
+
+        return level::scalar;
+    }();
+
+    return detected;
+#else
+    return level::scalar;
+#endif
+}
+
+inline level &
+__forced_level() noexcept
+{
+    static level forced = level::avx512;
+    return forced;
+}
+
+/**
+ * @brief Returns the instruction set the algorithms currently use
+ */
+inline level
+active_level() noexcept
+{
+    const level detected = detected_level();
+    const level forced   = __forced_level();
+
+    return (forced < detected) ? forced : detected;
+}
+
+/**
+ * @brief Caps the instruction set used by the algorithms at %l
+ *
+ * Mostly useful to compare code paths in tests and benchmarks. Levels above
+ * detected_level() are never used.
+ */
+inline void
+set_max_level(level l) noexcept
+{
+    __forced_level() = l;
+}
+
+template <typename Tp, std::size_t Bytes>
+struct __vec
+{
+    typedef Tp type __attribute__((vector_size(Bytes)));
+
+    // Same vector, but allowed to alias Tp and to sit at any address
+    // aligned for Tp
+    typedef Tp unaligned
+        __attribute__((vector_size(Bytes), aligned(alignof(Tp)), may_alias));
+};
+
+template <typename Tp, std::size_t Bytes>
+using __vec_t = typename __vec<Tp, Bytes>::type;
+
+/**
+ * @brief Views the %Bytes bytes at %p as one vector
+ *
+ * Returns a reference rather than a value: passing wide vectors by value
+ * across functions compiled for different targets changes the ABI.
+ */
+template <std::size_t Bytes, typename Tp>
+__DUTCPP_ALWAYS_INLINE const typename __vec<Tp, Bytes>::unaligned &
+__load(const Tp *p) noexcept
+{
+    return *reinterpret_cast<const typename __vec<Tp, Bytes>::unaligned *>(p);
+}
+
+/**
+ * @brief Checks if any lane of the comparison mask %m is set
+ */
+template <typename M>
+__DUTCPP_ALWAYS_INLINE bool
+__any(const M &m) noexcept
+{
+    using U = __vec_t<std::uint64_t, sizeof(M)>;
+
+    const U u = reinterpret_cast<const U &>(m);
+
+    std::uint64_t r = 0;
+    for (std::size_t i = 0; i < sizeof(M) / 8; ++i)
+        r |= u[i];
+
+    return r != 0;
+}
+
+// Each operation provides a scalar version and a vector version for a given
+// register width in bytes. The vector version is always inlined into the
+// per-target wrappers below, so it is compiled for that instruction set.
+
+struct __find_op
+{
+    template <typename Tp>
+    static std::size_t
+    scalar(const Tp *p, std::size_t n, Tp value) noexcept
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            if (p[i] == value)
+                return i;
+
+        return n;
+    }
+
+    template <std::size_t B, typename Tp>
+    static __DUTCPP_ALWAYS_INLINE std::size_t
+    run(const Tp *p, std::size_t n, Tp value) noexcept
+    {
+        using V                 = __vec_t<Tp, B>;
+        constexpr std::size_t L = B / sizeof(Tp);
+
+        const V s     = V{} + value;
+        std::size_t i = 0;
+
+        // Four registers per iteration, then pin down the lane with the
+        // scalar loop.
+        for (; i + 4 * L <= n; i += 4 * L)
+        {
+            const auto m = (__load<B>(p + i) == s) |
+                           (__load<B>(p + i + L) == s) |
+                           (__load<B>(p + i + 2 * L) == s) |
+                           (__load<B>(p + i + 3 * L) == s);
+
+            if (__any(m))
+                break;
+        }
+
+        return i + scalar(p + i, n - i, value);
+    }
+};
+
+struct __count_op
+{
+    template <typename Tp>
+    static std::size_t
+    scalar(const Tp *p, std::size_t n, Tp value) noexcept
+    {
+        std::size_t c = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            c += (p[i] == value);
+
+        return c;
+    }
+
+    template <std::size_t B, typename Tp>
+    static __DUTCPP_ALWAYS_INLINE std::size_t
+    run(const Tp *p, std::size_t n, Tp value) noexcept
+    {
+        using V                 = __vec_t<Tp, B>;
+        using M                 = decltype(V{} == V{});
+        constexpr std::size_t L = B / sizeof(Tp);
+
+        const V s         = V{} + value;
+        std::size_t total = 0;
+        std::size_t i     = 0;
+
+        // Matching lanes are -1, so subtracting counts them. Flush before
+        // 8-bit lanes can overflow.
+        while (i + L <= n)
+        {
+            M acc = M{};
+
+            for (int k = 0; k < 127 && i + L <= n; ++k, i += L)
+                acc -= (__load<B>(p + i) == s);
+
+            for (std::size_t k = 0; k < L; ++k)
+                total += std::size_t(acc[k]);
+        }
+
+        return total + scalar(p + i, n - i, value);
+    }
+};
+
+struct __min_op
+{
+    template <typename Tp>
+    static Tp
+    scalar(const Tp *p, std::size_t n) noexcept
+    {
+        Tp r = p[0];
+        for (std::size_t i = 1; i < n; ++i)
+            r = (p[i] < r) ? p[i] : r;
+
+        return r;
+    }
+
+    template <std::size_t B, typename Tp>
+    static __DUTCPP_ALWAYS_INLINE Tp
+    run(const Tp *p, std::size_t n) noexcept
+    {
+        using V                 = __vec_t<Tp, B>;
+        constexpr std::size_t L = B / sizeof(Tp);
+
+        if (n < L)
+            return scalar(p, n);
+
+        V m           = __load<B>(p);
+        std::size_t i = L;
+
+        for (; i + L <= n; i += L)
+        {
+            const V v = __load<B>(p + i);
+            m         = (v < m) ? v : m;
+        }
+
+        Tp r = m[0];
+        for (std::size_t k = 1; k < L; ++k)
+            r = (m[k] < r) ? m[k] : r;
+
+        for (; i < n; ++i)
+            r = (p[i] < r) ? p[i] : r;
+
+        return r;
+    }
+};
+
+struct __max_op
+{
+    template <typename Tp>
+    static Tp
+    scalar(const Tp *p, std::size_t n) noexcept
+    {
+        Tp r = p[0];
+        for (std::size_t i = 1; i < n; ++i)
+            r = (r < p[i]) ? p[i] : r;
+
+        return r;
+    }
+
+    template <std::size_t B, typename Tp>
+    static __DUTCPP_ALWAYS_INLINE Tp
+    run(const Tp *p, std::size_t n) noexcept
+    {
+        using V                 = __vec_t<Tp, B>;
+        constexpr std::size_t L = B / sizeof(Tp);
+
+        if (n < L)
+            return scalar(p, n);
+
+        V m           = __load<B>(p);
+        std::size_t i = L;
+
+        for (; i + L <= n; i += L)
+        {
+            const V v = __load<B>(p + i);
+            m         = (m < v) ? v : m;
+        }
+
+        Tp r = m[0];
+        for (std::size_t k = 1; k < L; ++k)
+            r = (r < m[k]) ? m[k] : r;
+
+        for (; i < n; ++i)
+            r = (r < p[i]) ? p[i] : r;
+
+        return r;
+    }
+};
+
+struct __sum_op
+{
+    template <typename Tp>
+    static simd_sum_t<Tp>
+    scalar(const Tp *p, std::size_t n) noexcept
+    {
+        simd_sum_t<Tp> r = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            r += p[i];
+
+        return r;
+    }
+
+    template <std::size_t B, typename Tp>
+    static __DUTCPP_ALWAYS_INLINE simd_sum_t<Tp>
+    run(const Tp *p, std::size_t n) noexcept
+    {
+        using R                 = simd_sum_t<Tp>;
+        constexpr std::size_t L = B / sizeof(Tp);
+        using VR                = __vec_t<R, L * sizeof(R)>;
+
+        // Two accumulators to hide the add latency
+        VR a0 = VR{};
+        VR a1 = VR{};
+
+        std::size_t i = 0;
+        for (; i + 2 * L <= n; i += 2 * L)
+        {
+            a0 += __builtin_convertvector(__load<B>(p + i), VR);
+            a1 += __builtin_convertvector(__load<B>(p + i + L), VR);
+        }
+
+        a0 += a1;
+
+        R r = 0;
+        for (std::size_t k = 0; k < L; ++k)
+            r += a0[k];
+
+        return r + scalar(p + i, n - i);
+    }
+};
+
+struct __fill_op
+{
+    template <typename Tp>
+    static void
+    scalar(Tp *p, std::size_t n, Tp value) noexcept
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            p[i] = value;
+    }
+
+    template <std::size_t B, typename Tp>
+    static __DUTCPP_ALWAYS_INLINE void
+    run(Tp *p, std::size_t n, Tp value) noexcept
+    {
+        using V                 = __vec_t<Tp, B>;
+        constexpr std::size_t L = B / sizeof(Tp);
+
+        const V s     = V{} + value;
+        std::size_t i = 0;
+
+        for (; i + L <= n; i += L)
+            *reinterpret_cast<typename __vec<Tp, B>::unaligned *>(p + i) = s;
+
+        scalar(p + i, n - i, value);
+    }
+};
+
+struct __equal_op
+{
+    template <typename Tp>
+    static bool
+    scalar(const Tp *a, const Tp *b, std::size_t n) noexcept
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            if (!(a[i] == b[i]))
+                return false;
+
+        return true;
+    }
+
+    template <std::size_t B, typename Tp>
+    static __DUTCPP_ALWAYS_INLINE bool
+    run(const Tp *a, const Tp *b, std::size_t n) noexcept
+    {
+        constexpr std::size_t L = B / sizeof(Tp);
+
+        std::size_t i = 0;
+        for (; i + 2 * L <= n; i += 2 * L)
+        {
+            const auto m = (__load<B>(a + i) != __load<B>(b + i)) |
+                           (__load<B>(a + i + L) != __load<B>(b + i + L));
+
+            if (__any(m))
+                return false;
+        }
+
+        return scalar(a + i, b + i, n - i);
+    }
+};
+
+/**
+ * @brief Gathers the bits of a comparison mask, bit k for lane k
+ */
+template <typename M>
+__DUTCPP_ALWAYS_INLINE unsigned
+__bits(const M &m) noexcept
+{
+    constexpr std::size_t L = sizeof(M) / sizeof(m[0]);
+
+    unsigned r = 0;
+    for (std::size_t k = 0; k < L; ++k)
+        r |= unsigned(m[k] & 1) << k;
+
+    return r;
+}
+
+/**
+ * @brief Permutations that move the selected lanes of an 8 x 32-bit vector
+ * to the front, in order
+ *
+ * Entry m lists the lanes whose bit is set in m, then the others.
+ */
+inline constexpr auto __compact_table = [] {
+    std::array<std::array<std::uint32_t, 8>, 256> t{};
+
+    for (unsigned m = 0; m < 256; ++m)
+    {
+        unsigned k = 0;
+
+        for (unsigned l = 0; l < 8; ++l)
+            if (m >> l & 1)
+                t[m][k++] = l;
+
+        for (unsigned l = 0; l < 8; ++l)
+            if (!(m >> l & 1))
+                t[m][k++] = l;
+    }
+
+    return t;
+}();
+
+/**
+ * @brief Keeps the elements that differ from %value
+ */
+template <typename Tp>
+struct __keep_unequal
+{
+    static constexpr bool vectorized = true;
+
+    Tp value;
+
+    bool
+    operator()(const Tp &x) const noexcept
+    {
+        return !(x == value);
+    }
+
+    template <std::size_t B>
+    __DUTCPP_ALWAYS_INLINE unsigned
+    mask(const Tp *p) const noexcept
+    {
+        using V = __vec_t<Tp, B>;
+        return __bits(__load<B>(p) != (V{} + value));
+    }
+};
+
+/**
+ * @brief Keeps the elements for which %pred returns false
+ *
+ * %pred only sees one element at a time, so building a lane mask from it
+ * costs more than the branch-free scalar loop saves: the compaction runs
+ * scalar at every level.
+ */
+template <typename Tp, typename Pred>
+struct __keep_unless
+{
+    static constexpr bool vectorized = false;
+
+    Pred pred;
+
+    bool
+    operator()(const Tp &x)
+    {
+        return !pred(x);
+    }
+};
+
+struct __compact_op
+{
+    /**
+     * @brief Copies the elements of [p, p + n) that %keep accepts to %out,
+     * in order, and returns how many there are
+     *
+     * Branch-free: every element is stored, and the output only advances
+     * past the kept ones. %out may be %p or lie before it.
+     */
+    template <typename Tp, typename Keep>
+    static std::size_t
+    scalar(const Tp *p, std::size_t n, Tp *out, Keep &keep)
+    {
+        std::size_t j = 0;
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const Tp x = p[i];
+            out[j]     = x;
+            j += keep(x);
+        }
+
+        return j;
+    }
+
+    template <typename Tp, typename Keep>
+    static std::size_t
+    scalar(Tp *p, std::size_t n, Keep keep)
+    {
+        return scalar(p, n, p, keep);
+    }
+
+    /**
+     * @brief Compacts [p, p + n) in place, returns the new length
+     *
+     * Works on 32 bytes at a time: the keep mask of the block selects a
+     * permutation from __compact_table that packs the kept lanes at the
+     * front, and the whole vector is stored at the output position, which
+     * never passes the input. 8-byte elements move as pairs of 32-bit lanes.
+     * Variable shuffles need AVX2, so 16-byte vectors, other element sizes
+     * and predicate masks use the scalar loop, and AVX-512 reuses the
+     * 32-byte kernel.
+     */
+    template <std::size_t B, typename Tp, typename Keep>
+    static __DUTCPP_ALWAYS_INLINE std::size_t
+    run(Tp *p, std::size_t n, Keep keep)
+    {
+        if constexpr (B < 32 || !Keep::vectorized ||
+                      (sizeof(Tp) != 4 && sizeof(Tp) != 8))
+            return scalar(p, n, p, keep);
+        else
+        {
+            using U  = __vec_t<std::uint32_t, 32>;
+            using UU = typename __vec<std::uint32_t, 32>::unaligned;
+
+            constexpr std::size_t L = 32 / sizeof(Tp);
+            constexpr unsigned all  = (1u << L) - 1;
+
+            std::size_t i = 0;
+
+            // Nothing moves until the first removed element.
+            for (; i + L <= n; i += L)
+                if (keep.template mask<32>(p + i) != all)
+                    break;
+
+            std::size_t j = i;
+
+            for (; i + L <= n; i += L)
+            {
+                const unsigned m = keep.template mask<32>(p + i);
+
+                // Lane k of an 8-byte element is 32-bit lanes 2k and 2k + 1.
+                const unsigned m32 =
+                    (sizeof(Tp) == 4) ? m
+                                      : ((m & 1) * 3 | (m & 2) * 6 |
+                                         (m & 4) * 12 | (m & 8) * 24);
+
+                const U v = __load<32>(
+                    reinterpret_cast<const std::uint32_t *>(p + i));
+                const U idx = __load<32>(__compact_table[m32].data());
+
+                *reinterpret_cast<UU *>(p + j) = __builtin_shuffle(v, idx);
+                j += std::popcount(m);
+            }
+
+            return j + scalar(p + i, n - i, p + j, keep);
+        }
+    }
+};
+
+#ifdef __DUTCPP_SIMD_X86
+template <typename Op, typename... Args>
+auto
+__run_sse2(Args... args) noexcept
+{
+    return Op::template run<16>(args...);
+}
+
+template <typename Op, typename... Args>
+__attribute__((target("avx2"))) auto
+__run_avx2(Args... args) noexcept
+{
+    return Op::template run<32>(args...);
+}
+
+template <typename Op, typename... Args>
+__attribute__((target("avx512f,avx512bw"))) auto
+__run_avx512(Args... args) noexcept
+{
+    return Op::template run<64>(args...);
+}
+#endif
+
+/**
+ * @brief Runs %Op with the widest enabled instruction set
+ */
+template <typename Op, typename... Args>
+inline auto
+__dispatch(Args... args) noexcept
+{
+#ifdef __DUTCPP_SIMD_X86
+    switch (active_level())
+    {
+    case level::avx512:
+        return __run_avx512<Op>(args...);
+    case level::avx2:
+        return __run_avx2<Op>(args...);
+    case level::sse2:
+        return __run_sse2<Op>(args...);
+    case level::scalar:
+        break;
+    }
+#endif
+
+    return Op::scalar(args...);
+}
+
+/**
+ * @brief Returns the index of the first element equal to %value, or
+ * s.size() if there is none
+ */
+template <simd_arithmetic Tp>
+inline std::size_t
+find(std::span<const Tp> s, Tp value) noexcept
+{
+    return __dispatch<__find_op>(s.data(), s.size(), value);
+}
+
+/**
+ * @brief Returns the number of elements equal to %value
+ */
+template <simd_arithmetic Tp>
+inline std::size_t
+count(std::span<const Tp> s, Tp value) noexcept
+{
+    return __dispatch<__count_op>(s.data(), s.size(), value);
+}
+
+/**
+ * @brief Checks if any element is equal to %value
+ */
+template <simd_arithmetic Tp>
+inline bool
+contains(std::span<const Tp> s, Tp value) noexcept
+{
+    return find(s, value) != s.size();
+}
+
+/**
+ * @brief Returns the smallest element
+ *
+ * %s must not be empty. The result is unspecified if %s contains NaN.
+ */
+template <simd_arithmetic Tp>
+inline Tp
+min(std::span<const Tp> s) noexcept
+{
+    return __dispatch<__min_op>(s.data(), s.size());
+}
+
+/**
+ * @brief Returns the largest element
+ *
+ * %s must not be empty. The result is unspecified if %s contains NaN.
+ */
+template <simd_arithmetic Tp>
+inline Tp
+max(std::span<const Tp> s) noexcept
+{
+    return __dispatch<__max_op>(s.data(), s.size());
+}
+
+/**
+ * @brief Returns the sum of all elements
+ *
+ * Floating-point values are added in a different order than a sequential
+ * loop, so the result may differ in the last bits.
+ */
+template <simd_arithmetic Tp>
+inline simd_sum_t<Tp>
+sum(std::span<const Tp> s) noexcept
+{
+    return __dispatch<__sum_op>(s.data(), s.size());
+}
+
+/**
+ * @brief Assigns %value to every element
+ */
+template <simd_arithmetic Tp>
+inline void
+fill(std::span<Tp> s, Tp value) noexcept
+{
+    __dispatch<__fill_op>(s.data(), s.size(), value);
+}
+
+/**
+ * @brief Checks if both spans hold the same elements, compared with ==
+ */
+template <simd_arithmetic Tp>
+inline bool
+equal(std::span<const Tp> a, std::span<const Tp> b) noexcept
+{
+    return a.size() == b.size() &&
+           __dispatch<__equal_op>(a.data(), b.data(), a.size());
+}
+
+/**
+ * @brief Moves the elements not equal to %value to the front, in order, and
+ * returns how many there are
+ *
+ * One pass over %s. Like std::remove, the elements past the returned length
+ * are left with unspecified values.
+ */
+template <simd_arithmetic Tp>
+inline std::size_t
+remove(std::span<Tp> s, Tp value) noexcept
+{
+    return __dispatch<__compact_op>(s.data(), s.size(),
+                                    __keep_unequal<Tp>{value});
+}
+
+/**
+ * @brief Moves the elements for which %pred returns false to the front, in
+ * order, and returns how many there are
+ *
+ * %pred is called exactly once per element, in order, and must not throw.
+ * The compaction is branch-free, so its speed does not depend on which
+ * elements are removed.
+ */
+template <simd_arithmetic Tp, typename Pred>
+inline std::size_t
+remove_if(std::span<Tp> s, Pred pred)
+{
+    return __dispatch<__compact_op>(s.data(), s.size(),
+                                    __keep_unless<Tp, Pred>{pred});
+}
+} // namespace simd
+
+template <simd_arithmetic Tp, typename Alloc, typename Growth>
+inline typename vector<Tp, Alloc, Growth>::const_iterator
+find(const vector<Tp, Alloc, Growth> &v, const Tp &value) noexcept
+{
+    return v.begin() + simd::find<Tp>({v.data(), v.size()}, value);
+}
+
+template <simd_arithmetic Tp, typename Alloc, typename Growth>
+inline typename vector<Tp, Alloc, Growth>::iterator
+find(vector<Tp, Alloc, Growth> &v, const Tp &value) noexcept
+{
+    return v.begin() + simd::find<Tp>({v.data(), v.size()}, value);
+}
+
+template <simd_arithmetic Tp, typename Alloc, typename Growth>
+inline std::size_t
+count(const vector<Tp, Alloc, Growth> &v, const Tp &value) noexcept
+{
+    return simd::count<Tp>({v.data(), v.size()}, value);
+}
+
+template <simd_arithmetic Tp, typename Alloc, typename Growth>
+inline bool
+contains(const vector<Tp, Alloc, Growth> &v, const Tp &value) noexcept
+{
+    return simd::contains<Tp>({v.data(), v.size()}, value);
+}
+
+/**
+ * @brief Returns the smallest element of a non-empty vector
+ */
+template <simd_arithmetic Tp, typename Alloc, typename Growth>
+inline Tp
+min(const vector<Tp, Alloc, Growth> &v) noexcept
+{
+    return simd::min<Tp>({v.data(), v.size()});
+}
+
+/**
+ * @brief Returns the largest element of a non-empty vector
+ */
+template <simd_arithmetic Tp, typename Alloc, typename Growth>
+inline Tp
+max(const vector<Tp, Alloc, Growth> &v) noexcept
+{
+    return simd::max<Tp>({v.data(), v.size()});
+}
+
+template <simd_arithmetic Tp, typename Alloc, typename Growth>
+inline simd_sum_t<Tp>
+sum(const vector<Tp, Alloc, Growth> &v) noexcept
+{
+    return simd::sum<Tp>({v.data(), v.size()});
+}
+
+template <simd_arithmetic Tp, typename Alloc, typename Growth>
+inline void
+fill(vector<Tp, Alloc, Growth> &v, const Tp &value) noexcept
+{
+    simd::fill<Tp>({v.data(), v.size()}, value);
+}
+
+template <simd_arithmetic Tp, typename Alloc, typename Growth>
+inline bool
+equal(const vector<Tp, Alloc, Growth> &a,
+      const vector<Tp, Alloc, Growth> &b) noexcept
+{
+    return simd::equal<Tp>({a.data(), a.size()}, {b.data(), b.size()});
+}
+
+/**
+ * @brief Removes every element equal to %value with a vectorized compaction
+ *
+ * Returns the number of removed elements.
+ */
+template <simd_arithmetic Tp, typename Alloc, typename Growth>
+inline typename vector<Tp, Alloc, Growth>::size_type
+erase(vector<Tp, Alloc, Growth> &v, const Tp &value)
+{
+    const std::size_t n       = simd::remove<Tp>({v.data(), v.size()}, value);
+    const std::size_t removed = v.size() - n;
+
+    v.erase(v.begin() + n, v.end());
+
+    return removed;
+}
+
+/**
+ * @brief Removes every element for which %pred returns true with a
+ * branch-free compaction
+ *
+ * Returns the number of removed elements.
+ */
+template <simd_arithmetic Tp, typename Alloc, typename Growth, typename Pred>
+inline typename vector<Tp, Alloc, Growth>::size_type
+erase_if(vector<Tp, Alloc, Growth> &v, Pred pred)
+{
+    const std::size_t n = simd::remove_if<Tp>({v.data(), v.size()}, pred);
+    const std::size_t removed = v.size() - n;
+
+    v.erase(v.begin() + n, v.end());
+
+    return removed;
+}
+} // namespace dutcpp
+
+#undef __DUTCPP_ALWAYS_INLINE
+
+#endif
@@ -0,0 +1,400 @@
+/**
+ * @file small_vector.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A vector that keeps its first few elements inline
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef __DUTCPP_SMALL_VECTOR_H
+#define __DUTCPP_SMALL_VECTOR_H 1
+
+#include "vector.h"
+
+namespace dutcpp
+{
+/**
+ * @brief Allocator used by small_vector
+ *
+ * Any request for at most %N elements is served from the inline buffer of the
+ * owning small_vector. Larger requests go to the upstream allocator %Alloc.
+ *
+ * vector only asks for a new buffer when the current one is too small, and
+ * allocate_at_least() reports the inline buffer as %N elements, so the inline
+ * buffer is never handed out twice.
+ */
+template <typename Tp, std::size_t N, typename Alloc>
+class __inline_allocator
+{
+    using upstream_traits = std::allocator_traits<Alloc>;
+
+public:
+    using value_type = Tp;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap            = std::false_type;
+    using is_always_equal                        = std::false_type;
+
+    __inline_allocator(Tp *buffer, const Alloc &upstream) noexcept
+    : _buffer(buffer), _upstream(upstream)
+    {
+    }
+
+    Tp *
+    allocate(std::size_t n)
+    {
+        return (n <= N) ? _buffer : upstream_traits::allocate(_upstream, n);
+    }
+
+    allocation_result<Tp *>
+    allocate_at_least(std::size_t n)
+    {
+        if (n <= N)
+            return {_buffer, N};
+
+        return {upstream_traits::allocate(_upstream, n), n};
+    }
+
+    void
+    deallocate(Tp *p, std::size_t n) noexcept
+    {
+        if (p != _buffer)
+            upstream_traits::deallocate(_upstream, p, n);
+    }
+
+    std::size_t
+    max_size() const noexcept
+    {
+        return upstream_traits::max_size(_upstream);
+    }
+
+    /**
+     * @brief Returns the allocator used for heap buffers
+     */
+    const Alloc &
+    upstream() const noexcept
+    {
+        return _upstream;
+    }
+
+    friend bool
+    operator==(const __inline_allocator &lhs,
+               const __inline_allocator &rhs) noexcept
+    {
+        return lhs._buffer == rhs._buffer && lhs._upstream == rhs._upstream;
+    }
+
+    friend bool
+    operator!=(const __inline_allocator &lhs,
+               const __inline_allocator &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    Tp *_buffer;
+    [[no_unique_address]] Alloc _upstream;
+};
+
+/**
+ * @brief Raw inline storage for %N objects of type %Tp
+ *
+ * A separate base class of small_vector, so that it is constructed before
+ * (and destroyed after) the vector that uses it.
+ */
+template <typename Tp, std::size_t N>
+struct __small_vector_storage
+{
+    alignas(Tp) unsigned char _inline[N * sizeof(Tp)];
+
+    Tp *
+    _inline_begin() noexcept
+    {
+        return reinterpret_cast<Tp *>(_inline);
+    }
+
+    const Tp *
+    _inline_begin() const noexcept
+    {
+        return reinterpret_cast<const Tp *>(_inline);
+    }
+};
+
+/**
+ * @brief A vector that stores up to %N elements inline
+ *
+ * Elements live in a buffer inside the object until the size exceeds %N,
+ * then they spill to memory from %Alloc. Everything else (iterators,
+ * insertion, growth through %Growth, relocation) is the vector core, so the
+ * behavior is identical to dutcpp::vector.
+ *
+ * Moving a small_vector takes over its heap buffer if it has one. Inline
+ * elements are moved one by one, and swapping goes through moves for the
+ * same reason. The vector core would copy and swap the buffer pointers
+ * instead, leaving two objects on one inline buffer, so it is a private base
+ * and only the rest of its interface is exported.
+ */
+template <typename Tp, std::size_t N, typename Alloc = std::allocator<Tp>,
+          typename Growth = doubling_growth>
+class small_vector
+: private __small_vector_storage<Tp, N>,
+  private vector<Tp, __inline_allocator<Tp, N, Alloc>, Growth>
+{
+    static_assert(N > 0, "small_vector needs at least one inline element");
+
+    using _storage = __small_vector_storage<Tp, N>;
+    using _base    = vector<Tp, __inline_allocator<Tp, N, Alloc>, Growth>;
+
+public:
+    using typename _base::allocator_type;
+    using typename _base::const_iterator;
+    using typename _base::const_pointer;
+    using typename _base::const_reference;
+    using typename _base::const_reverse_iterator;
+    using typename _base::difference_type;
+    using typename _base::iterator;
+    using typename _base::pointer;
+    using typename _base::reference;
+    using typename _base::reverse_iterator;
+    using typename _base::size_type;
+    using typename _base::value_type;
+
+    using _base::append_range;
+    using _base::append_uninitialized;
+    using _base::assign;
+    using _base::at;
+    using _base::back;
+    using _base::begin;
+    using _base::capacity;
+    using _base::cbegin;
+    using _base::cend;
+    using _base::clear;
+    using _base::commit_append;
+    using _base::crbegin;
+    using _base::crend;
+    using _base::data;
+    using _base::emplace;
+    using _base::emplace_back;
+    using _base::empty;
+    using _base::end;
+    using _base::erase;
+    using _base::front;
+    using _base::get_allocator;
+    using _base::insert;
+    using _base::max_size;
+    using _base::operator[];
+    using _base::pop_back;
+    using _base::push_back;
+    using _base::rbegin;
+    using _base::rend;
+    using _base::reserve;
+    using _base::resize;
+    using _base::resize_for_overwrite;
+    using _base::set_stats_label;
+    using _base::shrink_to_fit;
+    using _base::size;
+    using _base::stats;
+
+    small_vector() : small_vector(Alloc()) { }
+
+    explicit small_vector(const Alloc &alloc) : _base(_make_alloc(alloc))
+    {
+        this->reserve(N);
+    }
+
+    explicit small_vector(size_type count, const Alloc &alloc = Alloc())
+    : small_vector(alloc)
+    {
+        this->resize(count);
+    }
+
+    small_vector(size_type count, const_reference value,
+                 const Alloc &alloc = Alloc())
+    : small_vector(alloc)
+    {
+        this->insert(this->cend(), count, value);
+    }
+
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    small_vector(InputIter first, InputIter last, const Alloc &alloc = Alloc())
+    : small_vector(alloc)
+    {
+        this->insert(this->cend(), first, last);
+    }
+
+    small_vector(std::initializer_list<value_type> init,
+                 const Alloc &alloc = Alloc())
+    : small_vector(alloc)
+    {
+        this->insert(this->cend(), init);
+    }
+
+    small_vector(const small_vector &other)
+    : small_vector(std::allocator_traits<Alloc>::
+                       select_on_container_copy_construction(other._upstream()))
+    {
+        this->insert(this->cend(), other.begin(), other.end());
+    }
+
+    /**
+     * @brief Move constructor
+     *
+     * Takes over the heap buffer of %other, or moves its inline elements
+     * into the inline buffer of this small_vector, so only the moves of the
+     * elements can throw.
+     */
+    small_vector(small_vector &&other) noexcept(
+        std::is_nothrow_move_constructible<Tp>::value)
+    : small_vector(other._upstream())
+    {
+        _take(other);
+    }
+
+    small_vector &
+    operator=(const small_vector &other)
+    {
+        _base::operator=(other);
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment
+     *
+     * Besides the element moves, this can only throw if the upstream
+     * allocators of both sides may compare unequal: a heap buffer of %other
+     * cannot be taken over then, and its elements are moved into a new one
+     * from the upstream allocator of this small_vector.
+     */
+    small_vector &
+    operator=(small_vector &&other) noexcept(
+        std::is_nothrow_move_constructible<Tp>::value &&
+        std::is_nothrow_move_assignable<Tp>::value &&
+        std::allocator_traits<Alloc>::is_always_equal::value)
+    {
+        if (this != std::addressof(other))
+            _take(other);
+
+        return *this;
+    }
+
+    small_vector &
+    operator=(std::initializer_list<value_type> init)
+    {
+        _base::operator=(init);
+        return *this;
+    }
+
+    /**
+     * @brief Exchanges the contents of this small_vector with %other
+     */
+    void
+    swap(small_vector &other)
+    {
+        small_vector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    /**
+     * @brief Checks if the elements are stored in the inline buffer
+     */
+    bool
+    is_inline() const noexcept
+    {
+        return this->begin().base() == this->_inline_begin();
+    }
+
+    /**
+     * @brief Returns the number of elements that fit without a heap
+     * allocation
+     */
+    static constexpr size_type
+    inline_capacity() noexcept
+    {
+        return N;
+    }
+
+private:
+    __inline_allocator<Tp, N, Alloc>
+    _make_alloc(const Alloc &alloc) noexcept
+    {
+        return __inline_allocator<Tp, N, Alloc>(this->_inline_begin(), alloc);
+    }
+
+    Alloc
+    _upstream() const noexcept
+    {
+        return this->get_allocator().upstream();
+    }
+
+    /**
+     * @brief Moves the contents of %other into this small_vector
+     *
+     * A heap buffer is taken over as a whole if both sides use equal
+     * upstream allocators. %other is left empty, back on its inline buffer.
+     */
+    void
+    _take(small_vector &other)
+    {
+        if (!other.is_inline() && _upstream() == other._upstream())
+        {
+            this->_release();
+            this->_steal(other);
+            other.reserve(N);
+            return;
+        }
+
+        this->clear();
+        this->insert(this->cend(), std::make_move_iterator(other.begin()),
+                     std::make_move_iterator(other.end()));
+        other.clear();
+    }
+};
+
+template <typename Tp, std::size_t N, typename Alloc, typename Growth>
+inline void
+swap(small_vector<Tp, N, Alloc, Growth> &lhs,
+     small_vector<Tp, N, Alloc, Growth> &rhs)
+{
+    lhs.swap(rhs);
+}
+
+/**
+ * @brief Removes every element for which %pred returns true
+ *
+ * Returns the number of removed elements.
+ */
+template <typename Tp, std::size_t N, typename Alloc, typename Growth,
+          typename Pred>
+typename small_vector<Tp, N, Alloc, Growth>::size_type
+erase_if(small_vector<Tp, N, Alloc, Growth> &v, Pred pred)
+{
+    const auto last = std::remove_if(v.begin(), v.end(), pred);
+    const auto n    = v.end() - last;
+
+    v.erase(last, v.end());
+
+    return n;
+}
+
+/**
+ * @brief Removes every element equal to %value
+ *
+ * Returns the number of removed elements.
+ */
+template <typename Tp, std::size_t N, typename Alloc, typename Growth,
+          typename Up>
+typename small_vector<Tp, N, Alloc, Growth>::size_type
+erase(small_vector<Tp, N, Alloc, Growth> &v, const Up &value)
+{
+    return erase_if(v, [&value](const Tp &x) { return x == value; });
+}
+} // namespace dutcpp
+
+#endif
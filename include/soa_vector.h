@@ -0,0 +1,815 @@
+/**
+ * @file soa_vector.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief A vector of records stored column by column
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef __DUTCPP_SOA_VECTOR_H
+#define __DUTCPP_SOA_VECTOR_H 1
+
+#include <span>
+#include <tuple>
+#include <utility>
+
+#include "vector.h"
+
+namespace dutcpp
+{
+/**
+ * @brief Row of a soa_vector, made of one reference per column
+ *
+ * Returned by value from soa_vector::operator[] and its iterators. Reading a
+ * field goes through get<I>() or a structured binding; assigning a row or a
+ * std::tuple writes every field. It converts to the std::tuple value type,
+ * so standard algorithms such as std::sort work on soa_vector iterators.
+ */
+template <typename... Refs>
+class __soa_reference
+{
+public:
+    using value_type = std::tuple<std::remove_cvref_t<Refs>...>;
+
+    explicit __soa_reference(Refs... refs) noexcept : _refs(refs...) { }
+
+    __soa_reference(const __soa_reference &) noexcept = default;
+
+    template <typename... Others,
+              typename = typename std::enable_if<
+                  sizeof...(Others) == sizeof...(Refs) &&
+                  (std::is_convertible<Others, Refs>::value && ...)>::type>
+    __soa_reference(const __soa_reference<Others...> &other) noexcept
+    : _refs(other._refs)
+    {
+    }
+
+    /**
+     * @brief Returns the field in column %I
+     */
+    template <std::size_t I>
+    decltype(auto)
+    get() const noexcept
+    {
+        return std::get<I>(_refs);
+    }
+
+    operator value_type() const
+    {
+        return value_type(_refs);
+    }
+
+    const __soa_reference &
+    operator=(const __soa_reference &other) const
+    {
+        _assign(other._refs);
+        return *this;
+    }
+
+    const __soa_reference &
+    operator=(const value_type &value) const
+    {
+        _assign(value);
+        return *this;
+    }
+
+    const __soa_reference &
+    operator=(value_type &&value) const
+    {
+        _assign(std::move(value));
+        return *this;
+    }
+
+    friend void
+    swap(const __soa_reference &lhs, const __soa_reference &rhs)
+    {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            using std::swap;
+            (swap(std::get<I>(lhs._refs), std::get<I>(rhs._refs)), ...);
+        }(std::index_sequence_for<Refs...>());
+    }
+
+    friend bool
+    operator==(const __soa_reference &lhs, const __soa_reference &rhs)
+    {
+        return lhs._refs == rhs._refs;
+    }
+
+    friend bool
+    operator==(const __soa_reference &lhs, const value_type &rhs)
+    {
+        return lhs._refs == rhs;
+    }
+
+    friend bool
+    operator<(const __soa_reference &lhs, const __soa_reference &rhs)
+    {
+        return lhs._refs < rhs._refs;
+    }
+
+    friend bool
+    operator<(const __soa_reference &lhs, const value_type &rhs)
+    {
+        return lhs._refs < rhs;
+    }
+
+    friend bool
+    operator<(const value_type &lhs, const __soa_reference &rhs)
+    {
+        return lhs < rhs._refs;
+    }
+
+private:
+    template <typename...>
+    friend class __soa_reference;
+
+    template <typename Tuple>
+    void
+    _assign(Tuple &&values) const
+    {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((std::get<I>(_refs) = std::get<I>(std::forward<Tuple>(values))),
+             ...);
+        }(std::index_sequence_for<Refs...>());
+    }
+
+    std::tuple<Refs...> _refs;
+};
+
+template <std::size_t I, typename... Refs>
+inline decltype(auto)
+get(const __soa_reference<Refs...> &row) noexcept
+{
+    return row.template get<I>();
+}
+
+/**
+ * @brief One cache line, the allocation unit of soa_vector
+ */
+struct alignas(64) __soa_line
+{
+    unsigned char bytes[64];
+};
+
+/**
+ * @brief A vector of records of types %Ts..., stored as one contiguous array
+ * per field
+ *
+ * All columns share one buffer, one size and one capacity, so they grow
+ * together in a single allocation:
+ *
+ *     _buf
+ *      |
+ *      v
+ *      [ id 0 | id 1 | ... | id n | pad ][ price 0 | ... | price n | pad ]
+ *
+ * Every column starts on a cache line boundary. A scan over one field only
+ * brings that field into cache, and column<I>() hands it to the algorithms
+ * in simd_algorithm.h as a std::span.
+ *
+ * Rows are accessed through __soa_reference proxies, so operator[] returns by
+ * value and its result cannot be bound to a non-const lvalue reference.
+ */
+template <typename... Ts>
+class soa_vector
+{
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+    static_assert(((alignof(Ts) <= alignof(__soa_line)) && ...),
+                  "soa_vector columns must not be over-aligned");
+
+public:
+    using value_type      = std::tuple<Ts...>;
+    using reference       = __soa_reference<Ts &...>;
+    using const_reference = __soa_reference<const Ts &...>;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using allocator_type = std::allocator<__soa_line>;
+    using traits_t       = std::allocator_traits<allocator_type>;
+
+    using iterator               = __indexed_iterator<soa_vector, false>;
+    using const_iterator         = __indexed_iterator<soa_vector, true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    template <std::size_t I>
+    using column_type = typename std::tuple_element<I, value_type>::type;
+
+    static constexpr size_type column_count = sizeof...(Ts);
+
+    soa_vector() noexcept : _buf(), _columns(), _size(0), _capacity(0) { }
+
+    explicit soa_vector(size_type count) : soa_vector()
+    {
+        resize(count);
+    }
+
+    soa_vector(size_type count, const value_type &value) : soa_vector()
+    {
+        resize(count, value);
+    }
+
+    soa_vector(std::initializer_list<value_type> init) : soa_vector()
+    {
+        reserve(init.size());
+        for (const auto &row : init)
+            push_back(row);
+    }
+
+    soa_vector(const soa_vector &other) : soa_vector()
+    {
+        reserve(other.size());
+
+        for (size_type i = 0; i < other._size; ++i)
+            _construct_row(i, other._fields(i));
+    }
+
+    soa_vector(soa_vector &&other) noexcept
+    : _buf(other._buf), _columns(other._columns), _size(other._size),
+      _capacity(other._capacity)
+    {
+        other._buf      = nullptr;
+        other._columns  = {};
+        other._size     = 0;
+        other._capacity = 0;
+    }
+
+    soa_vector &
+    operator=(const soa_vector &other)
+    {
+        if (this != std::addressof(other))
+            soa_vector(other).swap(*this);
+
+        return *this;
+    }
+
+    soa_vector &
+    operator=(soa_vector &&other) noexcept
+    {
+        soa_vector(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~soa_vector()
+    {
+        clear();
+        _deallocate(_buf, _capacity);
+    }
+
+    void
+    swap(soa_vector &other) noexcept
+    {
+        std::swap(_buf, other._buf);
+        std::swap(_columns, other._columns);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    /**
+     * @brief Returns column %I as a contiguous span of size() elements
+     */
+    template <std::size_t I>
+    std::span<column_type<I>>
+    column() noexcept
+    {
+        return std::span<column_type<I>>(std::get<I>(_columns), _size);
+    }
+
+    template <std::size_t I>
+    std::span<const column_type<I>>
+    column() const noexcept
+    {
+        return std::span<const column_type<I>>(std::get<I>(_columns), _size);
+    }
+
+    /**
+     * @brief Same as column() const, for calling the span functions of
+     * simd_algorithm.h on a non-const soa_vector
+     */
+    template <std::size_t I>
+    std::span<const column_type<I>>
+    ccolumn() const noexcept
+    {
+        return column<I>();
+    }
+
+    template <std::size_t I>
+    column_type<I> *
+    data() noexcept
+    {
+        return std::get<I>(_columns);
+    }
+
+    template <std::size_t I>
+    const column_type<I> *
+    data() const noexcept
+    {
+        return std::get<I>(_columns);
+    }
+
+    iterator
+    begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    iterator
+    end() noexcept
+    {
+        return iterator(this, _size);
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(this, _size);
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return const_iterator(this, _size);
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    reference
+    operator[](size_type pos) noexcept
+    {
+        return _row<reference>(pos);
+    }
+
+    const_reference
+    operator[](size_type pos) const noexcept
+    {
+        return _row<const_reference>(pos);
+    }
+
+    reference
+    at(size_type pos)
+    {
+        if (pos >= _size)
+            std::__throw_out_of_range("soa_vector::at");
+
+        return _row<reference>(pos);
+    }
+
+    const_reference
+    at(size_type pos) const
+    {
+        if (pos >= _size)
+            std::__throw_out_of_range("soa_vector::at");
+
+        return _row<const_reference>(pos);
+    }
+
+    reference
+    front() noexcept
+    {
+        return _row<reference>(0);
+    }
+
+    const_reference
+    front() const noexcept
+    {
+        return _row<const_reference>(0);
+    }
+
+    reference
+    back() noexcept
+    {
+        return _row<reference>(_size - 1);
+    }
+
+    const_reference
+    back() const noexcept
+    {
+        return _row<const_reference>(_size - 1);
+    }
+
+    _GLIBCXX_NODISCARD bool
+    empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _size;
+    }
+
+    size_type
+    capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        constexpr size_type row_bytes = (sizeof(Ts) + ...);
+        constexpr size_type padding   = column_count * sizeof(__soa_line);
+
+        return (size_type(std::numeric_limits<difference_type>::max()) -
+                padding) /
+               row_bytes;
+    }
+
+    /**
+     * @brief Makes room for at least %n rows in every column
+     */
+    void
+    reserve(size_type n)
+    {
+        if (n > max_size())
+            std::__throw_length_error("soa_vector::reserve");
+
+        if (n > _capacity)
+            _reallocate(n);
+    }
+
+    void
+    shrink_to_fit()
+    {
+        if (_capacity > _size)
+            _reallocate(_size);
+    }
+
+    void
+    resize(size_type count)
+    {
+        if (count < _size)
+            _destroy_rows(count);
+        else
+        {
+            reserve(count);
+            while (_size < count)
+                _construct_row(_size, value_type());
+        }
+    }
+
+    void
+    resize(size_type count, const value_type &value)
+    {
+        if (count < _size)
+            _destroy_rows(count);
+        else
+        {
+            reserve(count);
+            while (_size < count)
+                _construct_row(_size, value);
+        }
+    }
+
+    void
+    clear() noexcept
+    {
+        _destroy_rows(0);
+    }
+
+    void
+    push_back(const value_type &value)
+    {
+        if (_size == _capacity)
+            _reallocate(_check_len());
+
+        _construct_row(_size, value);
+    }
+
+    void
+    push_back(value_type &&value)
+    {
+        if (_size == _capacity)
+            _reallocate(_check_len());
+
+        _construct_row(_size, std::move(value));
+    }
+
+    /**
+     * @brief Appends a row whose field in column I is constructed from the
+     * I-th argument
+     *
+     * The arguments may refer to fields of this soa_vector.
+     */
+    template <typename... Args,
+              typename = typename std::enable_if<sizeof...(Args) ==
+                                                 sizeof...(Ts)>::type>
+    reference
+    emplace_back(Args &&...args)
+    {
+        if (_size == _capacity)
+        {
+            value_type tmp(std::forward<Args>(args)...);
+            _reallocate(_check_len());
+            _construct_row(_size, std::move(tmp));
+        }
+        else
+            _construct_row(_size,
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+
+        return back();
+    }
+
+    void
+    pop_back() noexcept
+    {
+        _destroy_rows(_size - 1);
+    }
+
+private:
+    using column_pointers = std::tuple<Ts *...>;
+
+    __soa_line *_buf;
+    column_pointers _columns;
+    size_type _size;
+    size_type _capacity;
+
+    /**
+     * @brief Calls %fn with std::integral_constant<std::size_t, I> for each
+     * column I in order
+     */
+    template <typename Fn>
+    static void
+    _for_each_column(Fn &&fn)
+    {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (fn(std::integral_constant<std::size_t, I>()), ...);
+        }(std::index_sequence_for<Ts...>());
+    }
+
+    static constexpr size_type
+    _lines(size_type bytes) noexcept
+    {
+        return (bytes + sizeof(__soa_line) - 1) / sizeof(__soa_line);
+    }
+
+    /**
+     * @brief Returns the number of cache lines taken by %n rows
+     */
+    static constexpr size_type
+    _lines_for(size_type n) noexcept
+    {
+        return (_lines(n * sizeof(Ts)) + ...);
+    }
+
+    /**
+     * @brief Splits a buffer of _lines_for(%n) lines into the columns
+     */
+    static column_pointers
+    _carve(__soa_line *buf, size_type n) noexcept
+    {
+        column_pointers columns;
+
+        _for_each_column([&](auto ic) {
+            constexpr std::size_t I = ic();
+            using Tp                = column_type<I>;
+
+            std::get<I>(columns) = reinterpret_cast<Tp *>(buf);
+            buf += _lines(n * sizeof(Tp));
+        });
+
+        return columns;
+    }
+
+    void
+    _deallocate(__soa_line *buf, size_type n) noexcept
+    {
+        if (buf)
+        {
+            allocator_type alloc;
+            traits_t::deallocate(alloc, buf, _lines_for(n));
+        }
+    }
+
+    template <typename Row>
+    Row
+    _row(size_type pos) const noexcept
+    {
+        return std::apply([pos](auto *...p) { return Row(p[pos]...); },
+                          _columns);
+    }
+
+    std::tuple<const Ts &...>
+    _fields(size_type pos) const noexcept
+    {
+        return std::apply(
+            [pos](auto *...p) { return std::tuple<const Ts &...>(p[pos]...); },
+            _columns);
+    }
+
+    size_type
+    _check_len() const
+    {
+        if (_size == max_size())
+            std::__throw_length_error("soa_vector");
+
+        return doubling_growth::next_capacity<value_type>(_capacity, _size + 1,
+                                                          max_size());
+    }
+
+    /**
+     * @brief Constructs row %pos, field I from std::get<I>(%fields)
+     *
+     * If a constructor throws, the fields built so far are destroyed and
+     * the size is unchanged.
+     */
+    template <typename Tuple>
+    void
+    _construct_row(size_type pos, Tuple &&fields)
+    {
+        size_type built = 0;
+
+        try
+        {
+            _for_each_column([&](auto ic) {
+                constexpr std::size_t I = ic();
+                std::construct_at(std::get<I>(_columns) + pos,
+                                  std::get<I>(std::forward<Tuple>(fields)));
+                ++built;
+            });
+        }
+        catch (...)
+        {
+            _for_each_column([&](auto ic) {
+                constexpr std::size_t I = ic();
+                if (I < built)
+                    std::destroy_at(std::get<I>(_columns) + pos);
+            });
+            throw;
+        }
+
+        ++_size;
+    }
+
+    void
+    _destroy_rows(size_type first) noexcept
+    {
+        _for_each_column([&](auto ic) {
+            constexpr std::size_t I = ic();
+            std::destroy(std::get<I>(_columns) + first,
+                         std::get<I>(_columns) + _size);
+        });
+
+        _size = first;
+    }
+
+    /**
+     * @brief Whether reallocation moves the rows or copies them
+     *
+     * A row is only moved if no column can throw halfway: every column that
+     * is not trivially relocatable must be nothrow move constructible, or
+     * not copyable at all. Otherwise every copyable column is copied, since
+     * moving one column and then failing to copy the next would leave the
+     * first one moved-from.
+     */
+    static constexpr bool _move_on_realloc =
+        ((is_trivially_relocatable_v<Ts> ||
+          std::is_nothrow_move_constructible<Ts>::value ||
+          !std::is_copy_constructible<Ts>::value) &&
+         ...);
+
+    /**
+     * @brief Whether column elements of type %Tp are copied on reallocation
+     */
+    template <typename Tp>
+    static constexpr bool _copied_on_realloc =
+        !_move_on_realloc && !is_trivially_relocatable_v<Tp> &&
+        std::is_copy_constructible<Tp>::value;
+
+    /**
+     * @brief Moves every column into a new buffer for %new_len rows
+     *
+     * Columns of trivially relocatable types are copied byte-wise. Others are
+     * moved or copied as a whole, see _move_on_realloc. The copies run
+     * first, so a failure leaves this soa_vector unchanged unless a column
+     * that cannot be copied throws from its move constructor.
+     */
+    void
+    _reallocate(size_type new_len)
+    {
+        allocator_type alloc;
+        __soa_line *new_buf =
+            new_len ? traits_t::allocate(alloc, _lines_for(new_len)) : nullptr;
+        const column_pointers new_columns = _carve(new_buf, new_len);
+        bool built[sizeof...(Ts)]         = {};
+
+        // Copies run in the first pass, moves and relocations in the second
+        auto transfer = [&](auto ic, bool copying) {
+            constexpr std::size_t I = ic();
+            using Tp                = column_type<I>;
+
+            if (_copied_on_realloc<Tp> != copying)
+                return;
+
+            Tp *first = std::get<I>(_columns);
+            Tp *dest  = std::get<I>(new_columns);
+
+            if constexpr (is_trivially_relocatable_v<Tp>)
+            {
+                if (_size)
+                    std::memcpy(static_cast<void *>(dest),
+                                static_cast<const void *>(first),
+                                _size * sizeof(Tp));
+            }
+            else if constexpr (_copied_on_realloc<Tp>)
+                std::uninitialized_copy(first, first + _size, dest);
+            else
+                std::uninitialized_move(first, first + _size, dest);
+
+            built[I] = true;
+        };
+
+        try
+        {
+            _for_each_column([&](auto ic) { transfer(ic, true); });
+            _for_each_column([&](auto ic) { transfer(ic, false); });
+        }
+        catch (...)
+        {
+            _for_each_column([&](auto ic) {
+                constexpr std::size_t I = ic();
+                using Tp                = column_type<I>;
+
+                if (built[I] && !is_trivially_relocatable_v<Tp>)
+                    std::destroy(std::get<I>(new_columns),
+                                 std::get<I>(new_columns) + _size);
+            });
+            _deallocate(new_buf, new_len);
+            throw;
+        }
+
+        _for_each_column([&](auto ic) {
+            constexpr std::size_t I = ic();
+            using Tp                = column_type<I>;
+
+            if constexpr (!is_trivially_relocatable_v<Tp>)
+                std::destroy(std::get<I>(_columns),
+                             std::get<I>(_columns) + _size);
+        });
+
+        _deallocate(_buf, _capacity);
+
+        _buf      = new_buf;
+        _columns  = new_columns;
+        _capacity = new_len;
+    }
+};
+
+template <typename... Ts>
+inline void
+swap(soa_vector<Ts...> &lhs, soa_vector<Ts...> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+} // namespace dutcpp
+
+template <typename... Refs>
+struct std::tuple_size<dutcpp::__soa_reference<Refs...>>
+: std::integral_constant<std::size_t, sizeof...(Refs)>
+{
+};
+
+template <std::size_t I, typename... Refs>
+struct std::tuple_element<I, dutcpp::__soa_reference<Refs...>>
+{
+    using type = typename std::tuple_element<I, std::tuple<Refs...>>::type;
+};
+
+#endif
@@ -11,13 +11,128 @@
 #ifndef __DUTCPP_VECTOR_H
 #define __DUTCPP_VECTOR_H 1
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "mmap_storage.h"
+#include "parallel.h"
+#include "vector_stats.h"
 
 namespace dutcpp
 {
+/**
+ * @brief Checks if objects of type %Tp can be relocated with a byte copy
+ *
+ * Relocating an object means moving it to a new address and ending the
+ * lifetime of the source in one step. If this trait holds, containers are
+ * allowed to relocate elements with memcpy()/memmove() and skip destroying the
+ * source objects.
+ *
+ * All trivially copyable types qualify. Other types whose state does not
+ * depend on their own address (e.g. handle structs owning a raw pointer) can
+ * opt in by specializing this trait to std::true_type.
+ */
+template <typename Tp>
+struct is_trivially_relocatable : std::is_trivially_copyable<Tp>
+{
+};
+
+template <typename Tp>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<Tp>::value;
+
+/**
+ * @brief Growth policy that multiplies the capacity by %Num / %Den
+ *
+ * A growth policy decides the new capacity whenever a container runs out of
+ * room. It must provide a static member function template
+ *
+ *     template <typename Tp>
+ *     static constexpr std::size_t
+ *     next_capacity(std::size_t capacity, std::size_t required,
+ *                   std::size_t max_size);
+ *
+ * that returns a value in [required, max_size], and is constexpr so that
+ * vector stays usable in constant evaluation. Any factor greater than one
+ * gives amortized O(1) appends. Larger factors mean fewer reallocations but
+ * more unused capacity.
+ */
+template <std::size_t Num, std::size_t Den>
+struct geometric_growth
+{
+    static_assert(Den > 0 && Num > Den, "growth factor must be greater than 1");
+
+    template <typename Tp>
+    static constexpr std::size_t
+    next_capacity(std::size_t capacity, std::size_t required,
+                  std::size_t max_size) noexcept
+    {
+        // Guard the multiplication against overflow.
+        const std::size_t grown =
+            (capacity > max_size / Num) ? max_size : capacity * Num / Den;
+
+        return std::min(std::max(grown, required), max_size);
+    }
+};
+
+using doubling_growth     = geometric_growth<2, 1>;
+using one_and_half_growth = geometric_growth<3, 2>;
+
+/**
+ * @brief Growth policy that doubles the capacity, then rounds the allocation
+ * up to the next allocator size class
+ *
+ * Allocators such as jemalloc and tcmalloc serve requests from size classes
+ * with four classes per power of two (e.g. 1024, 1280, 1536, 1792, 2048). Any
+ * request in between is rounded up by the allocator anyway, so asking for the
+ * full class turns that slack into usable capacity.
+ */
+struct size_class_growth
+{
+    template <typename Tp>
+    static constexpr std::size_t
+    next_capacity(std::size_t capacity, std::size_t required,
+                  std::size_t max_size) noexcept
+    {
+        const std::size_t n =
+            doubling_growth::next_capacity<Tp>(capacity, required, max_size);
+
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(Tp) / 2)
+            return n;
+
+        const std::size_t bytes = _round_to_class(n * sizeof(Tp));
+
+        return std::min(bytes / sizeof(Tp), max_size);
+    }
+
+private:
+    static constexpr std::size_t
+    _round_to_class(std::size_t bytes) noexcept
+    {
+        if (bytes <= 16)
+            return 16;
+
+        // For sizes in (2^k, 2^(k+1)], classes are spaced 2^(k-2) bytes apart.
+        std::size_t k = 0;
+        while ((std::size_t(1) << (k + 1)) < bytes)
+            ++k;
+
+        const std::size_t spacing = std::size_t(1) << (k - 2);
+
+        return (bytes + spacing - 1) & ~(spacing - 1);
+    }
+};
+
 template <typename _Pointer, typename _Container>
 class __normal_iterator
 {
@@ -36,87 +151,94 @@ public:
 
     constexpr __normal_iterator() noexcept : _current(_Pointer()) { }
 
-    explicit __normal_iterator(const _Pointer &_p) noexcept : _current(_p) { }
+    constexpr explicit __normal_iterator(const _Pointer &_p) noexcept
+    : _current(_p)
+    {
+    }
 
     template <typename _Iter,
               typename = typename std::enable_if<
                   std::is_convertible<_Iter, _Pointer>::value, void>::type>
-    __normal_iterator(const __normal_iterator<_Iter, _Container> &_i) noexcept
+    constexpr __normal_iterator(
+        const __normal_iterator<_Iter, _Container> &_i) noexcept
     : _current(_i.base())
     {
     }
 
-    reference
+    constexpr reference
     operator*() const noexcept
     {
         return *_current;
     }
 
-    pointer
+    constexpr pointer
     operator->() const noexcept
     {
-        return _current;
+        if constexpr (std::is_pointer<_Pointer>::value)
+            return _current;
+        else
+            return _current.operator->();
     }
 
-    __normal_iterator &
+    constexpr __normal_iterator &
     operator++() noexcept
     {
         ++_current;
         return *this;
     }
 
-    __normal_iterator
+    constexpr __normal_iterator
     operator++(int) noexcept
     {
         return __normal_iterator(_current++);
     }
 
-    __normal_iterator &
+    constexpr __normal_iterator &
     operator--() noexcept
     {
         --_current;
         return *this;
     }
 
-    __normal_iterator
+    constexpr __normal_iterator
     operator--(int) noexcept
     {
         return __normal_iterator(_current--);
     }
 
-    reference
+    constexpr reference
     operator[](difference_type pos) const noexcept
     {
         return _current[pos];
     }
 
-    __normal_iterator &
+    constexpr __normal_iterator &
     operator+=(difference_type n) noexcept
     {
         _current += n;
         return *this;
     }
 
-    __normal_iterator
+    constexpr __normal_iterator
     operator+(difference_type n) const noexcept
     {
         return __normal_iterator(_current + n);
     }
 
-    __normal_iterator &
+    constexpr __normal_iterator &
     operator-=(difference_type n) noexcept
     {
         _current -= n;
         return *this;
     }
 
-    __normal_iterator
+    constexpr __normal_iterator
     operator-(difference_type n) const noexcept
     {
-        return ____normal_iterator(_current - n);
+        return __normal_iterator(_current - n);
     }
 
-    const _Pointer &
+    constexpr const _Pointer &
     base() const noexcept
     {
         return _current;
@@ -124,7 +246,7 @@ public:
 };
 
 template <typename _IteratorL, typename _IteratorR, typename _Container>
-inline bool
+constexpr bool
 operator==(const __normal_iterator<_IteratorL, _Container> &lhs,
            const __normal_iterator<_IteratorR, _Container> &rhs) noexcept
 {
@@ -132,7 +254,7 @@ operator==(const __normal_iterator<_IteratorL, _Container> &lhs,
 }
 
 template <typename _Iterator, typename _Container>
-inline bool
+constexpr bool
 operator==(const __normal_iterator<_Iterator, _Container> &lhs,
            const __normal_iterator<_Iterator, _Container> &rhs) noexcept
 {
@@ -140,7 +262,7 @@ operator==(const __normal_iterator<_Iterator, _Container> &lhs,
 }
 
 template <typename _IteratorL, typename _IteratorR, typename _Container>
-inline bool
+constexpr bool
 operator!=(const __normal_iterator<_IteratorL, _Container> &lhs,
            const __normal_iterator<_IteratorR, _Container> &rhs) noexcept
 {
@@ -148,7 +270,7 @@ operator!=(const __normal_iterator<_IteratorL, _Container> &lhs,
 }
 
 template <typename _Iterator, typename _Container>
-inline bool
+constexpr bool
 operator!=(const __normal_iterator<_Iterator, _Container> &lhs,
            const __normal_iterator<_Iterator, _Container> &rhs) noexcept
 {
@@ -156,7 +278,7 @@ operator!=(const __normal_iterator<_Iterator, _Container> &lhs,
 }
 
 template <typename _IteratorL, typename _IteratorR, typename _Container>
-inline bool
+constexpr bool
 operator<(const __normal_iterator<_IteratorL, _Container> &lhs,
           const __normal_iterator<_IteratorR, _Container> &rhs) noexcept
 {
@@ -164,7 +286,7 @@ operator<(const __normal_iterator<_IteratorL, _Container> &lhs,
 }
 
 template <typename _Iterator, typename _Container>
-inline bool
+constexpr bool
 operator<(const __normal_iterator<_Iterator, _Container> &lhs,
           const __normal_iterator<_Iterator, _Container> &rhs) noexcept
 {
@@ -172,7 +294,7 @@ operator<(const __normal_iterator<_Iterator, _Container> &lhs,
 }
 
 template <typename _IteratorL, typename _IteratorR, typename _Container>
-inline bool
+constexpr bool
 operator<=(const __normal_iterator<_IteratorL, _Container> &lhs,
            const __normal_iterator<_IteratorR, _Container> &rhs) noexcept
 {
@@ -180,7 +302,7 @@ operator<=(const __normal_iterator<_IteratorL, _Container> &lhs,
 }
 
 template <typename _Iterator, typename _Container>
-inline bool
+constexpr bool
 operator<=(const __normal_iterator<_Iterator, _Container> &lhs,
            const __normal_iterator<_Iterator, _Container> &rhs) noexcept
 {
@@ -188,7 +310,7 @@ operator<=(const __normal_iterator<_Iterator, _Container> &lhs,
 }
 
 template <typename _IteratorL, typename _IteratorR, typename _Container>
-inline bool
+constexpr bool
 operator>(const __normal_iterator<_IteratorL, _Container> &lhs,
           const __normal_iterator<_IteratorR, _Container> &rhs) noexcept
 {
@@ -196,7 +318,7 @@ operator>(const __normal_iterator<_IteratorL, _Container> &lhs,
 }
 
 template <typename _Iterator, typename _Container>
-inline bool
+constexpr bool
 operator>(const __normal_iterator<_Iterator, _Container> &lhs,
           const __normal_iterator<_Iterator, _Container> &rhs) noexcept
 {
@@ -204,7 +326,7 @@ operator>(const __normal_iterator<_Iterator, _Container> &lhs,
 }
 
 template <typename _IteratorL, typename _IteratorR, typename _Container>
-inline bool
+constexpr bool
 operator>=(const __normal_iterator<_IteratorL, _Container> &lhs,
            const __normal_iterator<_IteratorR, _Container> &rhs) noexcept
 {
@@ -212,7 +334,7 @@ operator>=(const __normal_iterator<_IteratorL, _Container> &lhs,
 }
 
 template <typename _Iterator, typename _Container>
-inline bool
+constexpr bool
 operator>=(const __normal_iterator<_Iterator, _Container> &lhs,
            const __normal_iterator<_Iterator, _Container> &rhs) noexcept
 {
@@ -220,7 +342,7 @@ operator>=(const __normal_iterator<_Iterator, _Container> &lhs,
 }
 
 template <typename _IteratorL, typename _IteratorR, typename _Container>
-inline auto
+constexpr auto
 operator-(const __normal_iterator<_IteratorL, _Container> &lhs,
           const __normal_iterator<_IteratorR, _Container> &rhs) noexcept
     -> decltype(lhs.base() - rhs.base())
@@ -229,7 +351,7 @@ operator-(const __normal_iterator<_IteratorL, _Container> &lhs,
 }
 
 template <typename _Iterator, typename _Container>
-inline typename __normal_iterator<_Iterator, _Container>::difference_type
+constexpr typename __normal_iterator<_Iterator, _Container>::difference_type
 operator-(const __normal_iterator<_Iterator, _Container> &lhs,
           const __normal_iterator<_Iterator, _Container> &rhs) noexcept
 {
@@ -237,14 +359,330 @@ operator-(const __normal_iterator<_Iterator, _Container> &lhs,
 }
 
 template <typename _Iterator, typename _Container>
-inline __normal_iterator<_Iterator, _Container>
+constexpr __normal_iterator<_Iterator, _Container>
 operator+(typename __normal_iterator<_Iterator, _Container>::difference_type n,
           const __normal_iterator<_Iterator, _Container> &i)
 {
     return __normal_iterator<_Iterator, _Container>(i.base() + n);
 }
 
+/**
+ * @brief Forward iterator that yields the same value %n times
+ *
+ * Used internally so that count insertion can share the range insertion
+ * code path.
+ */
+template <typename Tp>
+class __repeat_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Tp;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const Tp *;
+    using reference         = const Tp &;
+
+    constexpr __repeat_iterator(const Tp *value, difference_type n) noexcept
+    : _value(value), _n(n)
+    {
+    }
+
+    constexpr reference
+    operator*() const noexcept
+    {
+        return *_value;
+    }
+
+    constexpr __repeat_iterator &
+    operator++() noexcept
+    {
+        ++_n;
+        return *this;
+    }
+
+    constexpr __repeat_iterator
+    operator++(int) noexcept
+    {
+        return __repeat_iterator(_value, _n++);
+    }
+
+    friend constexpr bool
+    operator==(const __repeat_iterator &lhs,
+               const __repeat_iterator &rhs) noexcept
+    {
+        return lhs._n == rhs._n;
+    }
+
+    friend constexpr bool
+    operator!=(const __repeat_iterator &lhs,
+               const __repeat_iterator &rhs) noexcept
+    {
+        return lhs._n != rhs._n;
+    }
+
+private:
+    const Tp *_value;
+    difference_type _n;
+};
+
+/**
+ * @brief Random-access iterator that goes through %_Container::operator[]
+ *
+ * Used by containers whose elements are not contiguous (segmented storage,
+ * gap buffers). It holds the container and an index, so any position that
+ * operator[] accepts is a valid iterator position.
+ */
+template <typename _Container, bool _Const>
+class __indexed_iterator
+{
+    using container_type =
+        typename std::conditional<_Const, const _Container, _Container>::type;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename _Container::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using reference =
+        typename std::conditional<_Const,
+                                  typename _Container::const_reference,
+                                  typename _Container::reference>::type;
+    using pointer = typename std::conditional<_Const, const value_type *,
+                                              value_type *>::type;
+
+    constexpr __indexed_iterator() noexcept : _c(nullptr), _i(0) { }
+
+    __indexed_iterator(container_type *c, std::size_t i) noexcept
+    : _c(c), _i(i)
+    {
+    }
+
+    template <bool _OtherConst,
+              typename = typename std::enable_if<_Const && !_OtherConst>::type>
+    __indexed_iterator(
+        const __indexed_iterator<_Container, _OtherConst> &other) noexcept
+    : _c(other.container()), _i(other.index())
+    {
+    }
+
+    reference
+    operator*() const
+    {
+        return (*_c)[_i];
+    }
+
+    pointer
+    operator->() const
+    {
+        return std::addressof((*_c)[_i]);
+    }
+
+    reference
+    operator[](difference_type n) const
+    {
+        return (*_c)[_i + n];
+    }
+
+    __indexed_iterator &
+    operator++() noexcept
+    {
+        ++_i;
+        return *this;
+    }
+
+    __indexed_iterator
+    operator++(int) noexcept
+    {
+        return __indexed_iterator(_c, _i++);
+    }
+
+    __indexed_iterator &
+    operator--() noexcept
+    {
+        --_i;
+        return *this;
+    }
+
+    __indexed_iterator
+    operator--(int) noexcept
+    {
+        return __indexed_iterator(_c, _i--);
+    }
+
+    __indexed_iterator &
+    operator+=(difference_type n) noexcept
+    {
+        _i += n;
+        return *this;
+    }
+
+    __indexed_iterator &
+    operator-=(difference_type n) noexcept
+    {
+        _i -= n;
+        return *this;
+    }
+
+    __indexed_iterator
+    operator+(difference_type n) const noexcept
+    {
+        return __indexed_iterator(_c, _i + n);
+    }
+
+    __indexed_iterator
+    operator-(difference_type n) const noexcept
+    {
+        return __indexed_iterator(_c, _i - n);
+    }
+
+    friend __indexed_iterator
+    operator+(difference_type n, const __indexed_iterator &it) noexcept
+    {
+        return it + n;
+    }
+
+    friend difference_type
+    operator-(const __indexed_iterator &lhs,
+              const __indexed_iterator &rhs) noexcept
+    {
+        return difference_type(lhs._i) - difference_type(rhs._i);
+    }
+
+    friend bool
+    operator==(const __indexed_iterator &lhs,
+               const __indexed_iterator &rhs) noexcept
+    {
+        return lhs._i == rhs._i;
+    }
+
+    friend bool
+    operator!=(const __indexed_iterator &lhs,
+               const __indexed_iterator &rhs) noexcept
+    {
+        return lhs._i != rhs._i;
+    }
+
+    friend bool
+    operator<(const __indexed_iterator &lhs,
+              const __indexed_iterator &rhs) noexcept
+    {
+        return lhs._i < rhs._i;
+    }
+
+    friend bool
+    operator>(const __indexed_iterator &lhs,
+              const __indexed_iterator &rhs) noexcept
+    {
+        return lhs._i > rhs._i;
+    }
+
+    friend bool
+    operator<=(const __indexed_iterator &lhs,
+               const __indexed_iterator &rhs) noexcept
+    {
+        return lhs._i <= rhs._i;
+    }
+
+    friend bool
+    operator>=(const __indexed_iterator &lhs,
+               const __indexed_iterator &rhs) noexcept
+    {
+        return lhs._i >= rhs._i;
+    }
+
+    container_type *
+    container() const noexcept
+    {
+        return _c;
+    }
+
+    std::size_t
+    index() const noexcept
+    {
+        return _i;
+    }
+
+private:
+    container_type *_c;
+    std::size_t _i;
+};
+
+/**
+ * @brief The result of an allocate_at_least() call
+ *
+ * Mirrors the C++23 std::allocation_result. Allocators that can hand out more
+ * room than requested (size classes, inline buffers) may provide
+ *
+ *     allocation_result<Tp *> allocate_at_least(std::size_t n);
+ *
+ * and vector will use the whole block as capacity.
+ */
+template <typename Pointer>
+struct allocation_result
+{
+    Pointer ptr;
+    std::size_t count;
+};
+
+/**
+ * @brief Checks if %Alloc constructs and destroys %Tp objects the plain way
+ *
+ * Byte-wise relocation skips allocator_traits::construct() and destroy(), so
+ * it is only allowed when the allocator does not customize them, or when the
+ * customization has no effect on %Tp (std::pmr::polymorphic_allocator with a
+ * type that does not use allocators).
+ */
+template <typename Alloc, typename Tp>
+inline constexpr bool __alloc_constructs_plainly =
+    !requires(Alloc &a, Tp *p) { a.construct(p, std::declval<Tp &&>()); } &&
+    !requires(Alloc &a, Tp *p) { a.destroy(p); };
+
 template <typename Tp>
+inline constexpr bool
+    __alloc_constructs_plainly<std::pmr::polymorphic_allocator<Tp>, Tp> =
+        !std::uses_allocator_v<Tp, std::pmr::polymorphic_allocator<Tp>>;
+
+/**
+ * @brief Tag requesting default-initialized elements
+ *
+ * Elements of trivial types are then left indeterminate instead of being
+ * zeroed, for buffers whose contents are about to be overwritten.
+ */
+struct default_init_t
+{
+    explicit default_init_t() = default;
+};
+
+inline constexpr default_init_t default_init{};
+
+/**
+ * @brief Tag selecting the constructors that take a whole range
+ *
+ * Stands in for C++23 std::from_range_t.
+ */
+struct from_range_t
+{
+    explicit from_range_t() = default;
+};
+
+inline constexpr from_range_t from_range{};
+
+/**
+ * @brief A dynamic array
+ *
+ * Memory goes through %Alloc using std::allocator_traits, including the
+ * propagation rules on copy, move and swap. The one exception is a vector
+ * with std::allocator whose elements are trivially relocatable: on Linux,
+ * its buffers of mmap_threshold bytes or more are anonymous mappings grown
+ * with mremap() (see mmap_storage.h), and never reach the allocator.
+ * %Growth is the growth policy (see geometric_growth) that picks the new
+ * capacity whenever an insertion needs to reallocate.
+ *
+ * Everything but the parallel constructors is constexpr, so a vector can be
+ * built and used during constant evaluation. Its buffer cannot outlive the
+ * evaluation; to_array() copies the result into a std::array that can.
+ */
+template <typename Tp, typename Alloc = std::allocator<Tp>,
+          typename Growth = doubling_growth>
 class vector
 {
 public:
@@ -258,8 +696,14 @@ public:
     using size_type       = std::size_t;
     using difference_type = std::ptrdiff_t;
 
-    using allocator = std::allocator<Tp>;
-    using traits_t  = std::allocator_traits<allocator>;
+    using allocator_type = Alloc;
+    using allocator      = allocator_type;
+    using traits_t       = std::allocator_traits<allocator>;
+
+    static_assert(std::is_same<typename traits_t::value_type, Tp>::value,
+                  "vector must have the same value_type as its allocator");
+    static_assert(std::is_same<typename traits_t::pointer, Tp *>::value,
+                  "vector does not support fancy pointers");
 
     using iterator               = __normal_iterator<pointer, vector>;
     using const_iterator         = __normal_iterator<const_pointer, vector>;
@@ -272,7 +716,18 @@ public:
      * This constructor will construct a vector with zero capacity. New pushing
      * will do the first allocation.
      */
-    vector() : _start(), _finish(), _end() { }
+    constexpr vector() noexcept(noexcept(allocator_type()))
+    : _alloc(), _start(), _finish(), _end()
+    {
+    }
+
+    /**
+     * @brief Constructs an empty vector that allocates from %alloc
+     */
+    constexpr explicit vector(const allocator_type &alloc) noexcept
+    : _alloc(alloc), _start(), _finish(), _end()
+    {
+    }
 
     /**
      * @brief Default fill constructor
@@ -281,13 +736,15 @@ public:
      * %count elements. The value of all elements are the default value defined
      * by %value_type.
      */
-    explicit vector(size_type count)
+    constexpr explicit vector(size_type count,
+                              const allocator_type &alloc = allocator_type())
+    : _alloc(alloc)
     {
-        // Call to value_type() will invoke the default value for value_type.
-        // For example, if value_type (Tp) is an int, calling int() will be 0.
-        // For customized object, the value_type object must support default
+        // Each element is value-initialized in place, as by value_type(). For
+        // example, if value_type (Tp) is an int, every element will be 0. For
+        // customized object, the value_type object must support default
         // constructor.
-        _fill_initialize(count, value_type());
+        _fill_initialize(count);
     }
 
     /**
@@ -296,19 +753,48 @@ public:
      * Same as default fill constructor. But instead of filling default value,
      * the value of filled elements is a copy of the parameter %value.
      */
-    explicit vector(size_type count, const_reference value)
+    constexpr explicit vector(size_type count, const_reference value,
+                              const allocator_type &alloc = allocator_type())
+    : _alloc(alloc)
     {
         _fill_initialize(count, value);
     }
 
+    /**
+     * @brief Fill constructor with default-initialized elements
+     *
+     * Same as vector(count, alloc), but the elements are default-initialized
+     * (see resize_for_overwrite()): for trivial types, only the storage is
+     * allocated.
+     */
+    constexpr vector(default_init_t, size_type count,
+                     const allocator_type &alloc = allocator_type())
+    : _alloc(alloc)
+    {
+        _fill_initialize(count, default_init);
+    }
+
     /**
      * @brief Copy constructor
      *
      * This constructor will construct a new vector object and copy the data
      * from the %other vector to this newly-created vector. The original vector
      * is guaranteed to have its data unmodified.
+     *
+     * The allocator is obtained through
+     * select_on_container_copy_construction().
+     */
+    constexpr vector(const vector &other)
+    : _alloc(traits_t::select_on_container_copy_construction(other._alloc))
+    {
+        _range_initialize(std::cbegin(other), std::cend(other));
+    }
+
+    /**
+     * @brief Copy constructor that allocates from %alloc
      */
-    vector(const vector &other)
+    constexpr vector(const vector &other, const allocator_type &alloc)
+    : _alloc(alloc)
     {
         _range_initialize(std::cbegin(other), std::cend(other));
     }
@@ -319,8 +805,12 @@ public:
      * This constructor will construct a new vector object and transfer the
      * ownership from the %other vector to the newly-created vector. It
      * guarantees there is no copy happening.
+     *
+     * noexcept, so containers of vectors (e.g. std::vector<vector<T>>) move
+     * their elements instead of copying them when they grow.
      */
-    vector(vector &&other)
+    constexpr vector(vector &&other) noexcept
+    : _alloc(std::move(other._alloc))
     {
         this->_start  = other._start;
         this->_finish = other._finish;
@@ -331,6 +821,23 @@ public:
         other._end    = pointer();
     }
 
+    /**
+     * @brief Move constructor that allocates from %alloc
+     *
+     * The buffer of %other is taken over if %alloc compares equal to its
+     * allocator. Otherwise, the elements are moved one by one into storage
+     * from %alloc.
+     */
+    constexpr vector(vector &&other, const allocator_type &alloc)
+    : _alloc(alloc), _start(), _finish(), _end()
+    {
+        if (_alloc == other._alloc)
+            _steal(other);
+        else
+            _range_initialize(std::make_move_iterator(other._start),
+                              std::make_move_iterator(other._finish));
+    }
+
     /**
      * @brief Range constructor
      *
@@ -340,12 +847,18 @@ public:
      * If a container supports iterator methods such `begin()` and `end()`, it
      * will behave just like copy constructor, but the other object can be a
      * different class.
+     *
+     * Forward ranges are measured first and allocated exactly once.
+     * Single-pass input ranges (e.g. std::istream_iterator) are read once,
+     * growing the buffer as for push_back().
      */
     template <class InputIter,
               typename = typename ::std::enable_if<std::is_convertible<
                   typename std::iterator_traits<InputIter>::iterator_category,
                   std::input_iterator_tag>::value>::type>
-    vector(InputIter first, InputIter last)
+    constexpr vector(InputIter first, InputIter last,
+                     const allocator_type &alloc = allocator_type())
+    : _alloc(alloc)
     {
         // The reason why we need to add type check on InputIter is to remove
         // the ambiguity with the overload (size_type, value_type).
@@ -360,50 +873,305 @@ public:
      * This constructor will construct a new vector object and fill in the
      * vector with the data from the %init list.
      */
-    vector(std::initializer_list<value_type> init)
+    constexpr vector(std::initializer_list<value_type> init,
+                     const allocator_type &alloc = allocator_type())
+    : _alloc(alloc)
     {
         _range_initialize(init.begin(), init.end());
     }
 
-    ~vector()
+    /**
+     * @brief Constructs a vector with the elements of %range
+     *
+     * Sized and forward ranges are allocated exactly once, other input
+     * ranges (std::views::istream, generators, ...) are read in a single
+     * pass with geometric growth. The iterator and sentinel types may
+     * differ.
+     */
+    template <std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>,
+                                     value_type>
+    constexpr vector(from_range_t, Range &&range,
+                     const allocator_type &alloc = allocator_type())
+    : _alloc(alloc)
     {
-        const difference_type n = std::distance(this->_start, this->_finish);
-
-        for (auto curr = this->_start; curr != this->_finish; ++curr)
-            // See
-            // https://stackoverflow.com/questions/14820307/when-to-use-addressofx-instead-of-x
-            traits_t::destroy(_alloc, std::addressof(*curr));
-
-        _finish = _start;
-        traits_t::deallocate(_alloc, this->_start, n);
+        if constexpr (std::ranges::sized_range<Range> ||
+                      std::ranges::forward_range<Range>)
+            _range_initialize_n(std::ranges::begin(range),
+                                size_type(std::ranges::distance(range)));
+        else
+            _stream_initialize(std::ranges::begin(range),
+                               std::ranges::end(range));
     }
 
     /**
-     * @brief Returns a read/write iterator that points to the first element in
-     * the vector
+     * @brief Parallel default fill constructor
+     *
+     * Same as vector(count, alloc), but the elements are constructed by all
+     * threads of thread_pool::instance(), each building its own contiguous,
+     * page-aligned chunk. Small vectors, and allocators that customize
+     * construct(), are built serially.
+     *
+     * If a constructor throws, every element built so far is destroyed, the
+     * storage is released and the exception is rethrown.
      */
-    iterator
-    begin()
+    vector(parallel_policy, size_type count,
+           const allocator_type &alloc = allocator_type())
+    : _alloc(alloc)
     {
-        return iterator(this->_start);
+        _parallel_initialize(count, [this](pointer p, size_type) {
+            traits_t::construct(_alloc, p);
+        });
+
+        _stats.template on_construct<>(count);
     }
 
     /**
-     * @brief Returns a read iterator that points to the first element in the
-     * vector
+     * @brief Parallel fill constructor with specified value
      */
-    const_iterator
-    begin() const
+    vector(parallel_policy, size_type count, const_reference value,
+           const allocator_type &alloc = allocator_type())
+    : _alloc(alloc)
     {
-        return const_iterator(this->_start);
+        _parallel_initialize(count, [this, &value](pointer p, size_type) {
+            traits_t::construct(_alloc, p, value);
+        });
+
+        _stats.on_copy(count);
     }
 
     /**
-     * @brief Returns a read iterator that points to the first element in the
-     * vector
+     * @brief Parallel range constructor
+     *
+     * Only random-access ranges are split across threads. Other ranges are
+     * copied serially.
      */
-    const_iterator
-    cbegin() const
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    vector(parallel_policy, InputIter first, InputIter last,
+           const allocator_type &alloc = allocator_type())
+    : _alloc(alloc)
+    {
+        using category =
+            typename std::iterator_traits<InputIter>::iterator_category;
+
+        if constexpr (std::is_convertible<
+                          category, std::random_access_iterator_tag>::value)
+        {
+            const size_type n = std::distance(first, last);
+
+            _parallel_initialize(n, [this, &first](pointer p, size_type i) {
+                traits_t::construct(_alloc, p, first[i]);
+            });
+
+            _stats.template on_construct<decltype(*first)>(n);
+        }
+        else
+            _range_initialize(first, last);
+    }
+
+    constexpr ~vector()
+    {
+        if (!std::is_constant_evaluated())
+            _stats.on_destroy(size(), capacity());
+
+        _release();
+    }
+
+    /**
+     * @brief Copy assignment
+     *
+     * The allocator of %other is copied over if
+     * propagate_on_container_copy_assignment is true. Memory owned by the old
+     * allocator is released first if the two allocators are not equal.
+     *
+     * The buffer is reused if it is large enough, and existing elements are
+     * copy-assigned rather than destroyed and rebuilt, so they can keep their
+     * own storage (e.g. the buffers of strings).
+     */
+    constexpr vector &
+    operator=(const vector &other)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_copy_assignment::value)
+        {
+            if (!traits_t::is_always_equal::value && _alloc != other._alloc)
+                _release();
+
+            _alloc = other._alloc;
+        }
+
+        _assign_n(other._start, other.size());
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment
+     *
+     * The buffer of %other is taken over if
+     * propagate_on_container_move_assignment is true or both allocators are
+     * equal. Otherwise, the elements are moved one by one into storage from
+     * the current allocator.
+     */
+    constexpr vector &
+    operator=(vector &&other) noexcept(
+        traits_t::propagate_on_container_move_assignment::value ||
+        traits_t::is_always_equal::value)
+    {
+        if (this == std::addressof(other))
+            return *this;
+
+        if constexpr (traits_t::propagate_on_container_move_assignment::value)
+        {
+            _release();
+            _alloc = std::move(other._alloc);
+            _steal(other);
+        }
+        else if (traits_t::is_always_equal::value || _alloc == other._alloc)
+        {
+            _release();
+            _steal(other);
+        }
+        else
+        {
+            _assign_n(std::make_move_iterator(other._start), other.size());
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Replaces the contents with the elements of the %init list
+     */
+    constexpr vector &
+    operator=(std::initializer_list<value_type> init)
+    {
+        _assign_n(init.begin(), init.size());
+
+        return *this;
+    }
+
+    /**
+     * @brief Replaces the contents with %count copies of %value
+     *
+     * Like copy assignment, the buffer and the existing elements are reused
+     * when possible. %value may refer to an element of this vector.
+     */
+    constexpr void
+    assign(size_type count, const_reference value)
+    {
+        _assign_n(__repeat_iterator<Tp>(&value, 0), count);
+    }
+
+    /**
+     * @brief Replaces the contents with the elements in [first, last)
+     */
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    constexpr void
+    assign(InputIter first, InputIter last)
+    {
+        _assign_range(
+            first, last,
+            typename std::iterator_traits<InputIter>::iterator_category());
+    }
+
+    /**
+     * @brief Replaces the contents with the elements of the %init list
+     */
+    constexpr void
+    assign(std::initializer_list<value_type> init)
+    {
+        _assign_n(init.begin(), init.size());
+    }
+
+    /**
+     * @brief Exchanges the contents of this vector with %other
+     *
+     * Allocators are swapped only if propagate_on_container_swap is true.
+     * Otherwise, they must compare equal.
+     */
+    constexpr void
+    swap(vector &other) noexcept
+    {
+        if constexpr (traits_t::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(_alloc, other._alloc);
+        }
+
+        std::swap(_start, other._start);
+        std::swap(_finish, other._finish);
+        std::swap(_end, other._end);
+    }
+
+    /**
+     * @brief Returns a copy of the allocator
+     */
+    constexpr allocator_type
+    get_allocator() const noexcept
+    {
+        return _alloc;
+    }
+
+    /**
+     * @brief Returns the counters recorded by this vector so far
+     *
+     * All counters are zero unless DUTCPP_VECTOR_STATS is defined. See
+     * vector_stats.h.
+     */
+    vector_stats
+    stats() const noexcept
+    {
+        return _stats.get();
+    }
+
+    /**
+     * @brief Sets the registry entry this vector reports to when destroyed
+     *
+     * %label must outlive the vector, e.g. a string literal. Defaults to the
+     * element type name.
+     */
+    void
+    set_stats_label(const char *label) noexcept
+    {
+        _stats.set_label(label);
+    }
+
+    /**
+     * @brief Returns a read/write iterator that points to the first element in
+     * the vector
+     */
+    constexpr iterator
+    begin() noexcept
+    {
+        return iterator(this->_start);
+    }
+
+    /**
+     * @brief Returns a read iterator that points to the first element in the
+     * vector
+     */
+    constexpr const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(this->_start);
+    }
+
+    /**
+     * @brief Returns a read iterator that points to the first element in the
+     * vector
+     */
+    constexpr const_iterator
+    cbegin() const noexcept
     {
         return const_iterator(this->_start);
     }
@@ -412,146 +1180,1743 @@ public:
      * @brief Returns a read/write iterator that points to one-past the last
      * element in the vector
      */
-    iterator
-    end()
+    constexpr iterator
+    end() noexcept
     {
         return iterator(this->_finish);
     }
 
-    /**
-     * @brief Returns a read iterator that points to one-past the last element
-     * in the vector
-     */
-    const_iterator
-    end() const
-    {
-        return const_iterator(this->_finish);
+    /**
+     * @brief Returns a read iterator that points to one-past the last element
+     * in the vector
+     */
+    constexpr const_iterator
+    end() const noexcept
+    {
+        return const_iterator(this->_finish);
+    }
+
+    /**
+     * @brief Returns a read iterator that points to one-past the last element
+     * in the vector
+     */
+    constexpr const_iterator
+    cend() const noexcept
+    {
+        return const_iterator(this->_finish);
+    }
+
+    /**
+     * @brief Returns a read/write reversed iterator that points to one-past the
+     * last element in the vector
+     */
+    constexpr reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a read reversed iterator that points to one-past the last
+     * element in the vector
+     */
+    constexpr const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    /**
+     * @brief Returns a read reversed iterator that points to one-past the last
+     * element in the vector
+     */
+    constexpr const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    /**
+     * @brief Returns a read/write reversed iterator that points to the first
+     * element in the vector
+     */
+    constexpr reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a read reversed iterator that points to the first element
+     * in the vector
+     */
+    constexpr const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    /**
+     * @brief Returns a read reversed iterator that points to the first element
+     * in the vector
+     */
+    constexpr const_reverse_iterator
+    crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    /**
+     * @brief Returns a reference to the element at %pos, without bounds
+     * checking
+     */
+    constexpr reference
+    operator[](size_type pos) noexcept
+    {
+        return this->_start[pos];
+    }
+
+    /**
+     * @brief Returns a read reference to the element at %pos, without bounds
+     * checking
+     */
+    constexpr const_reference
+    operator[](size_type pos) const noexcept
+    {
+        return this->_start[pos];
+    }
+
+    /**
+     * @brief Returns a reference to the element at %pos
+     *
+     * Throws std::out_of_range if %pos >= size().
+     */
+    constexpr reference
+    at(size_type pos)
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("vector::at");
+
+        return this->_start[pos];
+    }
+
+    /**
+     * @brief Returns a read reference to the element at %pos
+     *
+     * Throws std::out_of_range if %pos >= size().
+     */
+    constexpr const_reference
+    at(size_type pos) const
+    {
+        if (pos >= size())
+            std::__throw_out_of_range("vector::at");
+
+        return this->_start[pos];
+    }
+
+    /**
+     * @brief Returns a reference to the first element
+     */
+    constexpr reference
+    front() noexcept
+    {
+        return *this->_start;
+    }
+
+    constexpr const_reference
+    front() const noexcept
+    {
+        return *this->_start;
+    }
+
+    /**
+     * @brief Returns a reference to the last element
+     */
+    constexpr reference
+    back() noexcept
+    {
+        return *(this->_finish - 1);
+    }
+
+    constexpr const_reference
+    back() const noexcept
+    {
+        return *(this->_finish - 1);
+    }
+
+    /**
+     * @brief Returns a pointer to the underlying contiguous storage
+     *
+     * [data(), data() + size()) is a valid range, even when the vector is
+     * empty.
+     */
+    constexpr pointer
+    data() noexcept
+    {
+        return this->_start;
+    }
+
+    constexpr const_pointer
+    data() const noexcept
+    {
+        return this->_start;
+    }
+
+    /**
+     * @brief Checks if the vector has no element
+     */
+    _GLIBCXX_NODISCARD constexpr bool
+    empty() const noexcept
+    {
+        // Assume _start and _finish are correctly positioned, then _start ==
+        // _finish means there is no element in the vector.
+        return begin() == end();
+    }
+
+    /**
+     * @brief Returns the number of elements in the vector
+     */
+    constexpr size_type
+    size() const noexcept
+    {
+        return std::distance(begin(), end());
+    }
+
+    /**
+     * @brief Returns the capacity of elements in the vector
+     */
+    constexpr size_type
+    capacity() const noexcept
+    {
+        return this->_end - this->_start;
+    }
+
+    /**
+     * @brief Returns the largest number of elements the vector can hold
+     */
+    constexpr size_type
+    max_size() const noexcept
+    {
+        return traits_t::max_size(_alloc);
+    }
+
+    /**
+     * @brief Makes room for at least %n elements
+     *
+     * If %n is greater than capacity(), the elements are moved into a new
+     * buffer of exactly %n elements and all iterators are invalidated.
+     * Otherwise, this method does nothing.
+     */
+    constexpr void
+    reserve(size_type n)
+    {
+        if (n > max_size())
+            std::__throw_length_error("vector::reserve");
+
+        if (n > capacity())
+            _reallocate(n);
+    }
+
+    /**
+     * @brief Releases unused capacity
+     *
+     * After calling this method, capacity() == size(). All iterators are
+     * invalidated if the capacity changes.
+     */
+    constexpr void
+    shrink_to_fit()
+    {
+        if (capacity() > size())
+            _reallocate(size());
+    }
+
+    /**
+     * @brief Resizes the vector to hold %count elements
+     *
+     * Extra elements are destroyed if %count is less than size(). Otherwise,
+     * value-initialized elements are appended.
+     */
+    constexpr void
+    resize(size_type count)
+    {
+        if (count < size())
+            _erase_at_end(_start + count);
+        else
+            _append_n(count - size());
+    }
+
+    /**
+     * @brief Resizes the vector to hold %count elements
+     *
+     * Same as resize(count), but appended elements are copies of %value.
+     */
+    constexpr void
+    resize(size_type count, const_reference value)
+    {
+        if (count < size())
+            _erase_at_end(_start + count);
+        else
+            _append_n(count - size(), value);
+    }
+
+    /**
+     * @brief Resizes the vector to hold %count elements, default-initializing
+     * the appended ones
+     *
+     * For trivial types the new elements are left indeterminate, so a buffer
+     * that is filled right after (by read(), a decompressor, ...) is written
+     * once instead of twice. Other types are default-constructed.
+     */
+    constexpr void
+    resize_for_overwrite(size_type count)
+    {
+        if (count < size())
+            _erase_at_end(_start + count);
+        else
+            _append_n(count - size(), default_init);
+    }
+
+    /**
+     * @brief Returns writable storage for %count elements past the end
+     *
+     * The capacity grows as for insertions, but size() is unchanged: the
+     * elements only become part of the vector once commit_append() is
+     * called, which allows writing fewer than %count. Any other change to
+     * the vector in between discards the span. Only for types that can be
+     * brought to life by writing their bytes.
+     *
+     * @code
+     *     auto buf = v.append_uninitialized(4096);
+     *     v.commit_append(::read(fd, buf.data(), buf.size_bytes()) /
+     *                     sizeof(buf[0]));
+     * @endcode
+     */
+    constexpr std::span<value_type>
+    append_uninitialized(size_type count)
+    {
+        static_assert(std::is_trivially_default_constructible<Tp>::value &&
+                          std::is_trivially_copyable<Tp>::value,
+                      "append_uninitialized needs an implicit-lifetime type");
+
+        if (size_type(_end - _finish) < count)
+            _reallocate(_check_len(count, "vector::append_uninitialized"));
+
+        // Storage is not an object in constant evaluation, it has to be
+        // constructed before it can be written.
+        if (std::is_constant_evaluated())
+            for (size_type i = 0; i < count; ++i)
+                traits_t::construct(_alloc, _finish + i);
+
+        return std::span<value_type>(_finish, count);
+    }
+
+    /**
+     * @brief Appends the first %count elements written to the span returned
+     * by the last append_uninitialized()
+     */
+    constexpr void
+    commit_append(size_type count) noexcept
+    {
+        this->_finish += count;
+        _stats.template on_construct<>(count);
+    }
+
+    /**
+     * @brief Destroys all elements in this vector
+     *
+     * After calling this method, size() == 0 and capacity() will remain
+     * unchanged.
+     */
+    constexpr void
+    clear() noexcept
+    {
+        if (size() <= 0)
+            return;
+
+        for (auto curr = begin(); curr != end(); ++curr)
+            // See
+            // https://stackoverflow.com/questions/14820307/when-to-use-addressofx-instead-of-x
+            traits_t::destroy(_alloc, std::addressof(*curr));
+
+        this->_finish = this->_start;
+    }
+
+    constexpr iterator
+    insert(const_iterator pos, const_reference value)
+    {
+        return emplace(pos, value);
+    }
+
+    /**
+     * @brief Inserts %value before %pos by moving it
+     */
+    constexpr iterator
+    insert(const_iterator pos, value_type &&value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    /**
+     * @brief Constructs a new element from %args before %pos
+     *
+     * At the end, or when the vector has to grow, the element is constructed
+     * directly in its final slot. Otherwise it is constructed aside, then
+     * moved into the slot opened by shifting the tail, since %args may refer
+     * to elements that are about to move.
+     *
+     * Returns an iterator to the new element.
+     */
+    template <typename... Args>
+    constexpr iterator
+    emplace(const_iterator pos, Args &&...args)
+    {
+        return _insert(pos, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Inserts %count copies of %value before %pos
+     *
+     * At most one reallocation and one shift happen, regardless of %count.
+     * Returns an iterator to the first inserted element, or %pos if %count is
+     * zero.
+     */
+    constexpr iterator
+    insert(const_iterator pos, size_type count, const_reference value)
+    {
+        const size_type n = pos - cbegin();
+
+        if (count == 0)
+            return begin() + n;
+
+        if (size_type(_end - _finish) < count)
+        {
+            // The new copies are built before the old elements move, so
+            // %value can safely refer to an element of this vector.
+            _range_insert_n(_start + n, __repeat_iterator<Tp>(&value, 0),
+                            count);
+        }
+        else
+        {
+            // Shifting would overwrite %value if it belongs to this vector.
+            const value_type copy(value);
+            _range_insert_n(_start + n, __repeat_iterator<Tp>(&copy, 0),
+                            count);
+        }
+
+        return begin() + n;
+    }
+
+    /**
+     * @brief Inserts the elements in [first, last) before %pos
+     *
+     * For forward iterators, the final size is computed once, so there is at
+     * most one reallocation and one shift, and the new elements are
+     * constructed directly into the gap. Single-pass input iterators are
+     * appended and then rotated into place.
+     *
+     * Returns an iterator to the first inserted element, or %pos if the range
+     * is empty.
+     */
+    template <class InputIter,
+              typename = typename ::std::enable_if<std::is_convertible<
+                  typename std::iterator_traits<InputIter>::iterator_category,
+                  std::input_iterator_tag>::value>::type>
+    constexpr iterator
+    insert(const_iterator pos, InputIter first, InputIter last)
+    {
+        const size_type n = pos - cbegin();
+
+        _range_insert(
+            _start + n, first, last,
+            typename std::iterator_traits<InputIter>::iterator_category());
+
+        return begin() + n;
+    }
+
+    /**
+     * @brief Inserts the elements of the %init list before %pos
+     */
+    constexpr iterator
+    insert(const_iterator pos, std::initializer_list<value_type> init)
+    {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    /**
+     * @brief Appends the elements of %range to the end of the vector
+     *
+     * Sized and forward ranges reallocate at most once, other input ranges
+     * are appended one element at a time. %range must not refer to the
+     * elements of this vector.
+     */
+    template <std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>,
+                                     value_type>
+    constexpr void
+    append_range(Range &&range)
+    {
+        if constexpr (std::ranges::sized_range<Range> ||
+                      std::ranges::forward_range<Range>)
+        {
+            const size_type count = std::ranges::distance(range);
+
+            if (size_type(_end - _finish) < count)
+                _reallocate(_check_len(count, "vector::append_range"));
+
+            pointer curr = _finish;
+            auto it      = std::ranges::begin(range);
+
+            try
+            {
+                for (; curr != _finish + count; ++curr, ++it)
+                    traits_t::construct(_alloc, curr, *it);
+            }
+            catch (...)
+            {
+                _destroy(_finish, curr);
+                throw;
+            }
+
+            this->_finish = curr;
+            _stats.template on_construct<std::ranges::range_reference_t<Range>>(
+                count);
+        }
+        else
+        {
+            for (auto &&x : range)
+                emplace_back(std::forward<decltype(x)>(x));
+        }
+    }
+
+    /**
+     * @brief Appends a copy of %value to the end of the vector
+     *
+     * Amortized O(1): when the vector is full, the capacity grows according
+     * to the %Growth policy.
+     */
+    constexpr void
+    push_back(const_reference value)
+    {
+        emplace_back(value);
+    }
+
+    /**
+     * @brief Appends %value to the end of the vector by moving it
+     */
+    constexpr void
+    push_back(value_type &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    /**
+     * @brief Constructs a new element at the end of the vector from %args
+     *
+     * Returns a reference to the new element.
+     */
+    template <typename... Args>
+    constexpr reference
+    emplace_back(Args &&...args)
+    {
+        if (_finish != _end)
+        {
+            traits_t::construct(_alloc, _finish, std::forward<Args>(args)...);
+            ++_finish;
+            _stats.template on_construct<Args &&...>(1);
+        }
+        else
+            _realloc_append(std::forward<Args>(args)...);
+
+        return *(_finish - 1);
+    }
+
+    /**
+     * @brief Removes the last element
+     *
+     * The vector must not be empty. The capacity is unchanged.
+     */
+    constexpr void
+    pop_back() noexcept
+    {
+        --this->_finish;
+        traits_t::destroy(_alloc, this->_finish);
+    }
+
+    /**
+     * @brief Removes the element at %pos
+     *
+     * Returns an iterator to the element that followed it.
+     */
+    constexpr iterator
+    erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    /**
+     * @brief Removes the elements in [first, last)
+     *
+     * The elements after %last are shifted down once, by the length of the
+     * range. Returns an iterator to the element that followed the last
+     * removed one.
+     *
+     * To remove many elements scattered through the vector, use erase_if(),
+     * which compacts the whole vector in a single pass.
+     */
+    constexpr iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        pointer p = _start + (first - cbegin());
+        pointer q = _start + (last - cbegin());
+
+        if (p == q)
+            return iterator(p);
+
+        _stats.on_move(_finish - q);
+
+        //       p       q                                                   //
+        // | 0 | 1 | 2 | 3 | 4 | 5 |   ->   | 0 | 3 | 4 | 5 |                 //
+        if (_relocating())
+        {
+            _destroy(p, q);
+            _relocate(q, _finish, p);
+            this->_finish -= q - p;
+        }
+        else
+            _erase_at_end(std::move(q, _finish, p));
+
+        return iterator(p);
+    }
+
+protected:
+    /**
+     * @brief Destroys all elements and gives the buffer back to the allocator
+     *
+     * Leaves the vector empty with zero capacity. Also used by containers
+     * that build on vector (e.g. small_vector) to hand buffers over.
+     */
+    constexpr void
+    _release() noexcept
+    {
+        _destroy(_start, _finish);
+        _deallocate(_start, capacity());
+
+        this->_start  = pointer();
+        this->_finish = pointer();
+        this->_end    = pointer();
+    }
+
+    /**
+     * @brief Takes over the buffer of %other and leaves it empty
+     */
+    constexpr void
+    _steal(vector &other) noexcept
+    {
+        this->_start  = other._start;
+        this->_finish = other._finish;
+        this->_end    = other._end;
+
+        other._start  = pointer();
+        other._finish = pointer();
+        other._end    = pointer();
+    }
+
+private:
+    // Elements can be moved to new storage with a bulk byte copy instead of
+    // a move-construct and a destroy per element.
+    static constexpr bool _relocatable =
+        is_trivially_relocatable_v<Tp> && __alloc_constructs_plainly<Alloc, Tp>;
+
+    // Byte copies are not allowed in constant evaluation, which takes the
+    // element-wise paths instead.
+    static constexpr bool
+    _relocating() noexcept
+    {
+        return _relocatable && !std::is_constant_evaluated();
+    }
+
+    // Large buffers can live in anonymous mappings grown with mremap() (see
+    // mmap_storage.h). This bypasses the allocator, so it is limited to
+    // std::allocator, which has no state and nothing to customize.
+    static constexpr bool _mappable =
+        mmap_growth_supported && _relocatable &&
+        std::is_same<Alloc, std::allocator<Tp>>::value &&
+        sizeof(Tp) <= __mmap_granule;
+
+    allocator _alloc;
+    pointer _start;
+    pointer _finish;
+    pointer _end;
+
+    // Empty unless DUTCPP_VECTOR_STATS is defined
+    [[no_unique_address]] __vector_stats_recorder<Tp> _stats;
+
+    /**
+     * @brief Relocates elements in [first, last) to the storage starting at
+     * %result
+     *
+     * Only valid when _relocatable is true. The two ranges may overlap. After
+     * this call, the objects in the source range are considered gone and must
+     * not be destroyed.
+     */
+    static void
+    _relocate(pointer first, pointer last, pointer result) noexcept
+    {
+        if (first != last)
+            std::memmove(static_cast<void *>(result),
+                         static_cast<const void *>(first),
+                         (last - first) * sizeof(value_type));
+    }
+
+    /**
+     * @brief Computes the capacity needed to insert %n more elements
+     *
+     * The result comes from the %Growth policy and is at least size() + n.
+     * Throws std::length_error with message %s if that exceeds max_size().
+     */
+    constexpr size_type
+    _check_len(size_type n, const char *s) const
+    {
+        if (max_size() - size() < n)
+            std::__throw_length_error(s);
+
+        return Growth::template next_capacity<value_type>(
+            capacity(), size() + n, max_size());
+    }
+
+    /**
+     * @brief Move-constructs the elements in [first, last) into uninitialized
+     * storage starting at %result
+     *
+     * Like std::uninitialized_move(), but through the allocator and usable in
+     * constant evaluation. If a constructor throws, the elements built so far
+     * are destroyed. Returns one-past the last constructed element.
+     */
+    constexpr pointer
+    _uninitialized_move(pointer first, pointer last, pointer result)
+    {
+        pointer curr = result;
+
+        try
+        {
+            for (; first != last; ++first, ++curr)
+                traits_t::construct(_alloc, curr, std::move(*first));
+        }
+        catch (...)
+        {
+            _destroy(result, curr);
+            throw;
+        }
+
+        return curr;
+    }
+
+    /**
+     * @brief Whether reallocation moves the old elements or copies them
+     *
+     * As in std::vector, elements whose move constructor may throw are copied
+     * if they can be, so that a throwing reallocation leaves the vector
+     * unchanged.
+     */
+    static constexpr bool _move_on_realloc =
+        std::is_nothrow_move_constructible<value_type>::value ||
+        !std::is_copy_constructible<value_type>::value;
+
+    /**
+     * @brief Like _uninitialized_move(), but copies instead unless
+     * _move_on_realloc holds
+     */
+    constexpr pointer
+    _uninitialized_move_if_noexcept(pointer first, pointer last,
+                                    pointer result)
+    {
+        if constexpr (_move_on_realloc)
+            return _uninitialized_move(first, last, result);
+        else
+        {
+            pointer curr = result;
+
+            try
+            {
+                for (; first != last; ++first, ++curr)
+                    traits_t::construct(_alloc, curr,
+                                        static_cast<const_reference>(*first));
+            }
+            catch (...)
+            {
+                _destroy(result, curr);
+                throw;
+            }
+
+            return curr;
+        }
+    }
+
+    /**
+     * @brief Records %n elements carried over to a new buffer
+     */
+    constexpr void
+    _on_realloc_transfer(size_type n) noexcept
+    {
+        if (_relocating() || _move_on_realloc)
+            _stats.on_move(n);
+        else
+            _stats.on_copy(n);
+    }
+
+    /**
+     * @brief Moves the elements in [first, last) into uninitialized storage
+     * starting at %result and destroys the sources
+     *
+     * Elements are copied instead if their move constructor may throw, see
+     * _move_on_realloc. Returns one-past the last constructed element.
+     */
+    constexpr pointer
+    _transfer(pointer first, pointer last, pointer result)
+    {
+        _on_realloc_transfer(last - first);
+
+        if (_relocating())
+        {
+            _relocate(first, last, result);
+            return result + (last - first);
+        }
+        else
+        {
+            pointer finish =
+                _uninitialized_move_if_noexcept(first, last, result);
+
+            for (pointer curr = first; curr != last; ++curr)
+                traits_t::destroy(_alloc, std::addressof(*curr));
+
+            return finish;
+        }
+    }
+
+    /**
+     * @brief Moves all elements into a new buffer of %new_len elements
+     */
+    constexpr void
+    _reallocate(size_type new_len)
+    {
+        if (_can_remap(new_len))
+        {
+            _remap(new_len);
+            return;
+        }
+
+        pointer new_start = new_len ? _allocate(new_len) : pointer();
+        pointer new_finish;
+
+        if (new_start && new_start == _start)
+        {
+            // The allocator handed back the current buffer (e.g. the inline
+            // storage of a small_vector), nothing needs to move.
+            this->_end = new_start + new_len;
+            return;
+        }
+
+        if (_start)
+            _stats.on_reallocate();
+
+        try
+        {
+            new_finish = _transfer(_start, _finish, new_start);
+        }
+        catch (...)
+        {
+            _deallocate(new_start, new_len);
+            throw;
+        }
+
+        _deallocate(_start, capacity());
+
+        this->_start  = new_start;
+        this->_finish = new_finish;
+        this->_end    = new_start + new_len;
+    }
+
+    /**
+     * @brief Allocates room for at least %n elements
+     *
+     * If the allocator provides allocate_at_least(), it is used and %n is
+     * updated to the number of elements actually obtained, so the vector can
+     * use the whole block as capacity.
+     */
+    constexpr pointer
+    _allocate(size_type &n)
+    {
+        pointer p;
+
+        if (_mapped(n))
+        {
+            size_type bytes = n * sizeof(value_type);
+            p               = static_cast<pointer>(__mmap_allocate(bytes));
+            n               = bytes / sizeof(value_type);
+        }
+        else if constexpr (requires(allocator &a) { a.allocate_at_least(n); })
+        {
+            auto result = _alloc.allocate_at_least(n);
+            n           = result.count;
+            p           = result.ptr;
+        }
+        else
+            p = traits_t::allocate(_alloc, n);
+
+        _stats.on_allocate(n);
+
+        return p;
+    }
+
+    /**
+     * @brief Gives a buffer of %n elements back to the allocator
+     *
+     * Null pointers are skipped, as some allocators (e.g.
+     * std::pmr::polymorphic_allocator) do not accept them.
+     */
+    constexpr void
+    _deallocate(pointer p, size_type n) noexcept
+    {
+        if (!p)
+            return;
+
+        if (_mapped(n))
+            __mmap_deallocate(p, n * sizeof(value_type));
+        else
+            traits_t::deallocate(_alloc, p, n);
+    }
+
+    /**
+     * @brief Checks if a buffer of %n elements is an anonymous mapping
+     *
+     * The choice depends on %n alone, so _deallocate() can tell which way a
+     * buffer of capacity() elements was obtained.
+     */
+    static constexpr bool
+    _mapped(size_type n) noexcept
+    {
+        // Buffers allocated in constant evaluation never leave it, they
+        // always come from the allocator.
+        if constexpr (_mappable)
+            return !std::is_constant_evaluated() &&
+                   n >= mmap_threshold / sizeof(value_type);
+        else
+            return false;
+    }
+
+    /**
+     * @brief Checks if the buffer can be resized to %new_len with _remap()
+     */
+    constexpr bool
+    _can_remap(size_type new_len) const noexcept
+    {
+        return _start && _mapped(capacity()) && _mapped(new_len);
+    }
+
+    /**
+     * @brief Resizes a mapped buffer to at least %new_len elements in place
+     *
+     * mremap() carries the pages over, possibly to a new address, so nothing
+     * is copied and the old and new buffers never exist at the same time.
+     * Iterators and references are invalidated. Throws std::bad_alloc with
+     * the vector unchanged if the kernel refuses.
+     */
+    void
+    _remap(size_type new_len)
+    {
+        const size_type n = size();
+        size_type bytes   = new_len * sizeof(value_type);
+        pointer p         = static_cast<pointer>(
+            __mmap_reallocate(_start, capacity() * sizeof(value_type), bytes));
+
+        new_len = bytes / sizeof(value_type);
+        _stats.on_allocate(new_len);
+        _stats.on_reallocate();
+
+        this->_start  = p;
+        this->_finish = p + n;
+        this->_end    = p + new_len;
+    }
+
+    /**
+     * @brief Destroys the elements in [first, last)
+     */
+    constexpr void
+    _destroy(pointer first, pointer last) noexcept
+    {
+        for (; first != last; ++first)
+            traits_t::destroy(_alloc, std::addressof(*first));
+    }
+
+    /**
+     * @brief Whether %args describe elements whose bytes are all zero
+     *
+     * No arguments stand for value-initialized elements.
+     */
+    template <typename... Args>
+    static bool
+    _zero_fill(const Args &...args) noexcept
+    {
+        if constexpr (sizeof...(Args) == 0 &&
+                      std::is_trivially_copyable<Tp>::value &&
+                      std::is_trivially_default_constructible<Tp>::value)
+            return _zero_fill(value_type());
+        else if constexpr (sizeof...(Args) == 1 &&
+                           (std::is_same<Args, value_type>::value && ...) &&
+                           std::is_trivially_copyable<Tp>::value)
+        {
+            unsigned char c;
+            return _byte_fill(args..., c) && c == 0;
+        }
+        else
+            return false;
+    }
+
+    /**
+     * @brief Checks if every byte of %value is the same, and stores it in %c
+     */
+    static bool
+    _byte_fill(const_reference value, unsigned char &c) noexcept
+    {
+        unsigned char bytes[sizeof(value_type)];
+        std::memcpy(bytes, std::addressof(value), sizeof(value_type));
+
+        c = bytes[0];
+        return std::all_of(bytes, bytes + sizeof(value_type),
+                           [c](unsigned char b) { return b == c; });
+    }
+
+    /**
+     * @brief Constructs %count elements from %args in the uninitialized
+     * storage at %first
+     *
+     * No %args value-initializes the elements, and default_init
+     * default-initializes them. If a constructor throws, the elements built
+     * so far are destroyed.
+     *
+     * Trivial types with a plain allocator skip the per-element calls:
+     * default-initialization does nothing, and a fill is a memset() when
+     * every byte of the value is the same (zero, for value-initialized
+     * arithmetic types) and a std::uninitialized_fill_n() the compiler turns
+     * into vector stores otherwise.
+     */
+    template <typename... Args>
+    constexpr void
+    _construct_n(pointer first, size_type count, const Args &...args)
+    {
+        constexpr bool default_init =
+            (std::is_same<Args, default_init_t>::value && ...) &&
+            sizeof...(Args) == 1;
+        constexpr bool trivial =
+            std::is_trivially_copyable<Tp>::value &&
+            std::is_trivially_default_constructible<Tp>::value &&
+            __alloc_constructs_plainly<Alloc, Tp>;
+
+        if (!std::is_constant_evaluated())
+        {
+            if constexpr (trivial && default_init)
+                return;
+            else if constexpr (trivial && sizeof...(Args) == 0)
+            {
+                _construct_n(first, count, value_type());
+                return;
+            }
+            else if constexpr (trivial && sizeof...(Args) == 1 &&
+                               (std::is_same<Args, value_type>::value && ...))
+            {
+                const value_type &value = (args, ...);
+                unsigned char c;
+
+                if (_byte_fill(value, c))
+                    std::memset(static_cast<void *>(first), c,
+                                count * sizeof(value_type));
+                else
+                    std::uninitialized_fill_n(first, count, value);
+
+                return;
+            }
+        }
+
+        pointer curr = first;
+
+        try
+        {
+            for (; count > 0; --count, ++curr)
+            {
+                if constexpr (default_init)
+                {
+                    if (std::is_constant_evaluated() ||
+                        !__alloc_constructs_plainly<Alloc, Tp>)
+                        traits_t::construct(_alloc, curr);
+                    else
+                        ::new (static_cast<void *>(curr)) value_type;
+                }
+                else
+                    traits_t::construct(_alloc, curr, args...);
+            }
+        }
+        catch (...)
+        {
+            _destroy(first, curr);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Destroys all elements in [pos, end())
+     */
+    constexpr void
+    _erase_at_end(pointer pos) noexcept
+    {
+        _destroy(pos, _finish);
+        this->_finish = pos;
+    }
+
+    /**
+     * @brief Replaces the contents with the %n elements starting at %first
+     *
+     * If %n fits in the current capacity the buffer is kept: the first
+     * min(n, size()) elements are assigned over, the rest are constructed or
+     * destroyed. Otherwise a new buffer is filled before the old one is
+     * released, so nothing changes if a constructor throws.
+     */
+    template <class ForwardIter>
+    constexpr void
+    _assign_n(ForwardIter first, size_type n)
+    {
+        using ref = decltype(*first);
+
+        if (n > capacity())
+        {
+            if (n > max_size())
+                std::__throw_length_error("vector::assign");
+
+            size_type new_len = n;
+            pointer new_start = _allocate(new_len);
+            pointer curr      = new_start;
+
+            try
+            {
+                for (size_type i = 0; i < n; ++i, ++first, ++curr)
+                    traits_t::construct(_alloc, curr, *first);
+            }
+            catch (...)
+            {
+                _destroy(new_start, curr);
+                _deallocate(new_start, new_len);
+                throw;
+            }
+
+            _release();
+            _stats.template on_construct<ref>(n);
+
+            this->_start  = new_start;
+            this->_finish = curr;
+            this->_end    = new_start + new_len;
+        }
+        else if (n <= size())
+        {
+            pointer last = _start;
+
+            for (size_type i = 0; i < n; ++i, ++first, ++last)
+                *last = *first;
+
+            _erase_at_end(last);
+        }
+        else
+        {
+            const size_type old = size();
+
+            for (pointer p = _start; p != _finish; ++p, ++first)
+                *p = *first;
+
+            for (size_type i = old; i < n; ++i, ++first, ++_finish)
+                traits_t::construct(_alloc, _finish, *first);
+
+            _stats.template on_construct<ref>(n - old);
+        }
+    }
+
+    template <class InputIter>
+    constexpr void
+    _assign_range(InputIter first, InputIter last, std::input_iterator_tag)
+    {
+        // The length is unknown up front: assign over what is there, then
+        // either drop the leftovers or append the rest.
+        pointer curr = _start;
+
+        for (; first != last && curr != _finish; ++first, ++curr)
+            *curr = *first;
+
+        if (curr != _finish)
+            _erase_at_end(curr);
+        else
+            for (; first != last; ++first)
+                emplace_back(*first);
+    }
+
+    template <class ForwardIter>
+    constexpr void
+    _assign_range(ForwardIter first, ForwardIter last,
+                  std::forward_iterator_tag)
+    {
+        _assign_n(first, size_type(std::distance(first, last)));
+    }
+
+    template <class InputIter>
+    constexpr void
+    _range_insert(pointer pos, InputIter first, InputIter last,
+                  std::input_iterator_tag)
+    {
+        // The length is unknown up front: append everything, then rotate the
+        // new elements into place.
+        const size_type n        = pos - _start;
+        const size_type old_size = size();
+
+        try
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+        catch (...)
+        {
+            _erase_at_end(_start + old_size);
+            throw;
+        }
+
+        std::rotate(_start + n, _start + old_size, _finish);
+        _stats.on_move(old_size - n);
+    }
+
+    template <class ForwardIter>
+    constexpr void
+    _range_insert(pointer pos, ForwardIter first, ForwardIter last,
+                  std::forward_iterator_tag)
+    {
+        const size_type count = std::distance(first, last);
+
+        if (count > 0)
+            _range_insert_n(pos, first, count);
+    }
+
+    /**
+     * @brief Inserts the %count elements starting at %first before %pos
+     */
+    template <class ForwardIter>
+    constexpr void
+    _range_insert_n(pointer pos, ForwardIter first, size_type count)
+    {
+        if (size_type(_end - _finish) < count)
+        {
+            _realloc_range_insert(pos, first, count);
+            return;
+        }
+
+        _stats.template on_construct<decltype(*first)>(count);
+        _stats.on_move(_finish - pos);
+
+        if (_relocating())
+        {
+            //       pos                  _f
+            // ---------------------------------------------                  //
+            // | 0 | 1 | 2 | 3 | 4 | 5 | x | x | x | x | x |                  //
+            // ---------------------------------------------                  //
+            //                      v
+            // ---------------------------------------------                  //
+            // | 0 | ? | ? | ? | 1 | 2 | 3 | 4 | 5 | x | x |                  //
+            // ---------------------------------------------                  //
+            //                      v
+            // ---------------------------------------------                  //
+            // | 0 | a | b | c | 1 | 2 | 3 | 4 | 5 | x | x |                  //
+            // ---------------------------------------------                  //
+            _relocate(pos, _finish, pos + count);
+
+            pointer curr = pos;
+
+            try
+            {
+                for (; curr != pos + count; ++curr, ++first)
+                    traits_t::construct(_alloc, curr, *first);
+            }
+            catch (...)
+            {
+                // Close the gap again
+                _destroy(pos, curr);
+                _relocate(pos + count, _finish + count, pos);
+                throw;
+            }
+
+            this->_finish += count;
+        }
+        else
+        {
+            pointer old_finish          = _finish;
+            const size_type elems_after = old_finish - pos;
+
+            if (elems_after > count)
+            {
+                // The last %count elements move into uninitialized storage,
+                // the rest shift by assignment.
+                _uninitialized_move(old_finish - count, old_finish, old_finish);
+                this->_finish += count;
+
+                std::move_backward(pos, old_finish - count, old_finish);
+                std::copy_n(first, count, pos);
+            }
+            else
+            {
+                // Part of the new elements land past the old end and are
+                // constructed there directly.
+                ForwardIter mid = first;
+                std::advance(mid, elems_after);
+
+                pointer curr = old_finish;
+
+                try
+                {
+                    for (; curr != pos + count; ++curr, ++mid)
+                        traits_t::construct(_alloc, curr, *mid);
+
+                    _uninitialized_move(pos, old_finish, curr);
+                }
+                catch (...)
+                {
+                    _destroy(old_finish, curr);
+                    throw;
+                }
+
+                this->_finish += count;
+
+                std::copy_n(first, elems_after, pos);
+            }
+        }
+    }
+
+    /**
+     * @brief Inserts %count elements starting at %first before %pos in a
+     * new buffer
+     */
+    template <class ForwardIter>
+    constexpr void
+    _realloc_range_insert(pointer pos, ForwardIter first, size_type count)
+    {
+        size_type new_len = _check_len(count, "vector::insert");
+        pointer new_start = _allocate(new_len);
+        pointer new_pos   = new_start + (pos - _start);
+        pointer curr      = new_pos;
+
+        if (_start)
+            _stats.on_reallocate();
+
+        _stats.template on_construct<decltype(*first)>(count);
+        _on_realloc_transfer(size());
+
+        try
+        {
+            // Construct the new elements first, the old ones are untouched
+            // if this fails.
+            for (; curr != new_pos + count; ++curr, ++first)
+                traits_t::construct(_alloc, curr, *first);
+
+            if (_relocating())
+            {
+                _relocate(_start, pos, new_start);
+                _relocate(pos, _finish, curr);
+            }
+            else
+            {
+                pointer moved =
+                    _uninitialized_move_if_noexcept(_start, pos, new_start);
+
+                try
+                {
+                    _uninitialized_move_if_noexcept(pos, _finish, curr);
+                }
+                catch (...)
+                {
+                    _destroy(new_start, moved);
+                    throw;
+                }
+
+                _destroy(_start, _finish);
+            }
+        }
+        catch (...)
+        {
+            _destroy(new_pos, curr);
+            _deallocate(new_start, new_len);
+            throw;
+        }
+
+        const size_type new_size = size() + count;
+        _deallocate(_start, capacity());
+
+        this->_start  = new_start;
+        this->_finish = new_start + new_size;
+        this->_end    = new_start + new_len;
+    }
+
+    /**
+     * @brief Appends %count elements, each constructed from %args
+     *
+     * With no %args, the new elements are value-initialized, and with
+     * default_init they are default-initialized. When a reallocation is
+     * needed, the new elements are built in the new buffer before the old
+     * elements are moved, so %args may refer to elements of this vector.
+     */
+    template <typename... Args>
+    constexpr void
+    _append_n(size_type count, const Args &...args)
+    {
+        if (count == 0)
+            return;
+
+        if constexpr (_mappable)
+        {
+            const size_type new_len =
+                (size_type(_end - _finish) < count)
+                    ? _check_len(count, "vector::resize")
+                    : 0;
+
+            if (new_len && _can_remap(new_len))
+            {
+                // %args may refer to an element, and the buffer may move
+                if constexpr (sizeof...(Args) == 0 ||
+                              (std::is_same<Args, default_init_t>::value &&
+                               ...))
+                {
+                    _remap(new_len);
+                    _append_n(count, args...);
+                }
+                else
+                {
+                    const value_type tmp(args...);
+
+                    _remap(new_len);
+                    _append_n(count, tmp);
+                }
+
+                return;
+            }
+        }
+
+        _stats.template on_construct<const Args &...>(count);
+
+        if (size_type(_end - _finish) >= count)
+        {
+            _construct_n(_finish, count, args...);
+            this->_finish += count;
+            return;
+        }
+
+        size_type new_len = _check_len(count, "vector::resize");
+        pointer new_start = _allocate(new_len);
+        pointer mid       = new_start + size();
+
+        if (_start)
+            _stats.on_reallocate();
+
+        try
+        {
+            _construct_n(mid, count, args...);
+        }
+        catch (...)
+        {
+            _deallocate(new_start, new_len);
+            throw;
+        }
+
+        try
+        {
+            _transfer(_start, _finish, new_start);
+        }
+        catch (...)
+        {
+            _destroy(mid, mid + count);
+            _deallocate(new_start, new_len);
+            throw;
+        }
+
+        _deallocate(_start, capacity());
+
+        this->_start  = new_start;
+        this->_finish = mid + count;
+        this->_end    = new_start + new_len;
     }
 
     /**
-     * @brief Returns a read iterator that points to one-past the last element
-     * in the vector
+     * @brief Appends an element constructed from %args to a full vector
+     *
+     * Like _realloc_insert() at end(), but nothing needs to be shifted and
+     * the new element is constructed directly in the new buffer.
      */
-    const_iterator
-    cend() const
+    template <typename... Args>
+    constexpr void
+    _realloc_append(Args &&...args)
     {
-        return const_iterator(this->_finish);
-    }
+        size_type new_len = _check_len(1, "vector::push_back");
 
-    /**
-     * @brief Returns a read/write reversed iterator that points to one-past the
-     * last element in the vector
-     */
-    reverse_iterator
-    rbegin()
-    {
-        return reverse_iterator(end());
-    }
+        if (_can_remap(new_len))
+        {
+            // %args may refer to an element, and the buffer may move
+            value_type tmp(std::forward<Args>(args)...);
 
-    /**
-     * @brief Returns a read reversed iterator that points to one-past the last
-     * element in the vector
-     */
-    const_reverse_iterator
-    rbegin() const
-    {
-        return const_reverse_iterator(cend());
-    }
+            _remap(new_len);
+            _stats.template on_construct<Args &&...>(1);
+            traits_t::construct(_alloc, this->_finish, std::move(tmp));
+            ++this->_finish;
+            return;
+        }
 
-    /**
-     * @brief Returns a read reversed iterator that points to one-past the last
-     * element in the vector
-     */
-    const_reverse_iterator
-    crbegin() const
-    {
-        return const_reverse_iterator(cend());
-    }
+        pointer new_start = _allocate(new_len);
+        const size_type n = size();
 
-    /**
-     * @brief Returns a read/write reversed iterator that points to the first
-     * element in the vector
-     */
-    reverse_iterator
-    rend()
-    {
-        return reverse_iterator(begin());
-    }
+        if (_start)
+            _stats.on_reallocate();
 
-    /**
-     * @brief Returns a read reversed iterator that points to the first element
-     * in the vector
-     */
-    const_reverse_iterator
-    rend() const
-    {
-        return const_reverse_iterator(cbegin());
+        _stats.template on_construct<Args &&...>(1);
+
+        try
+        {
+            traits_t::construct(_alloc, new_start + n,
+                                std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            _deallocate(new_start, new_len);
+            throw;
+        }
+
+        try
+        {
+            _transfer(_start, _finish, new_start);
+        }
+        catch (...)
+        {
+            traits_t::destroy(_alloc, new_start + n);
+            _deallocate(new_start, new_len);
+            throw;
+        }
+
+        _deallocate(_start, capacity());
+
+        this->_start  = new_start;
+        this->_finish = new_start + n + 1;
+        this->_end    = new_start + new_len;
     }
 
+private:
     /**
-     * @brief Returns a read reversed iterator that points to the first element
-     * in the vector
+     * @brief Allocates exactly %count elements and constructs them from
+     * %args, see _construct_n()
      */
-    const_reverse_iterator
-    crend() const
+    template <typename... Args>
+    constexpr void
+    _fill_initialize(size_type count, const Args &...args)
     {
-        return const_reverse_iterator(cbegin());
+        size_type len = count;
+        this->_start  = _allocate(len);
+        this->_finish = this->_start;
+        this->_end    = this->_start + len;
+
+        try
+        {
+            // A fresh mapping already reads as zeros
+            if (!(_mapped(len) && _zero_fill(args...)))
+                _construct_n(this->_start, count, args...);
+        }
+        catch (...)
+        {
+            _deallocate(this->_start, len);
+            throw;
+        }
+
+        this->_finish = this->_start + count;
+        _stats.template on_construct<const Args &...>(count);
     }
 
-    /**
-     * @brief Checks if the vector has no element
-     */
-    _GLIBCXX_NODISCARD bool
-    empty() const
+    template <class InputIter>
+    constexpr void
+    _range_initialize(InputIter first, InputIter last)
     {
-        // Assume _start and _finish are correctly positioned, then _start ==
-        // _finish means there is no element in the vector.
-        return begin() == end();
+        using category =
+            typename std::iterator_traits<InputIter>::iterator_category;
+
+        if constexpr (std::is_convertible<category,
+                                          std::forward_iterator_tag>::value)
+            _range_initialize_n(first, size_type(std::distance(first, last)));
+        else
+            _stream_initialize(first, last);
     }
 
     /**
-     * @brief Returns the number of elements in the vector
+     * @brief Allocates exactly %count elements and copies them from the
+     * range starting at %first
+     *
+     * Contiguous ranges of the same trivial type are copied with memcpy().
      */
-    size_type
-    size() const
+    template <class ForwardIter>
+    constexpr void
+    _range_initialize_n(ForwardIter first, size_type count)
     {
-        return std::distance(begin(), end());
+        if (count > max_size())
+            std::__throw_length_error("vector::vector");
+
+        size_type len = count;
+        this->_start  = _allocate(len);
+        this->_finish = this->_start;
+        this->_end    = this->_start + len;
+
+        if constexpr (std::contiguous_iterator<ForwardIter> &&
+                      std::is_same<std::iter_value_t<ForwardIter>, Tp>::value &&
+                      std::is_trivially_copyable<Tp>::value &&
+                      __alloc_constructs_plainly<Alloc, Tp>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                if (count)
+                    std::memcpy(static_cast<void *>(this->_start),
+                                std::to_address(first),
+                                count * sizeof(value_type));
+
+                this->_finish = this->_start + count;
+                _stats.template on_construct<decltype(*first)>(count);
+                return;
+            }
+        }
+
+        try
+        {
+            for (; this->_finish != this->_start + count;
+                 ++this->_finish, ++first)
+                traits_t::construct(_alloc, this->_finish, *first);
+        }
+        catch (...)
+        {
+            _release();
+            throw;
+        }
+
+        _stats.template on_construct<decltype(*first)>(count);
     }
 
     /**
-     * @brief Returns the capacity of elements in the vector
+     * @brief Builds the vector from a single pass over [first, last)
+     *
+     * The length is unknown up front, so the buffer grows as for push_back().
      */
-    size_type
-    capacity() const
+    template <class InputIter, class Sentinel>
+    constexpr void
+    _stream_initialize(InputIter first, Sentinel last)
     {
-        return this->_end - this->_start;
+        this->_start  = pointer();
+        this->_finish = pointer();
+        this->_end    = pointer();
+
+        try
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+        catch (...)
+        {
+            _release();
+            throw;
+        }
     }
 
     /**
-     * @brief Destroys all elements in this vector
+     * @brief Allocates %count elements and builds them in parallel chunks
      *
-     * After calling this method, size() == 0 and capacity() will remain
-     * unchanged.
+     * %construct(p, i) must construct the element with index i at %p. Each
+     * chunk destroys what it built if one of its constructions throws. The
+     * other chunks report how far they got, so that everything can be torn
+     * down before the exception leaves the constructor.
      */
+    template <typename Construct>
     void
-    clear() noexcept
+    _parallel_initialize(size_type count, Construct construct)
     {
-        if (size() <= 0)
+        size_type len = count;
+        this->_start  = _allocate(len);
+        this->_finish = this->_start;
+        this->_end    = this->_start + len;
+
+        thread_pool &pool = thread_pool::instance();
+        const __parallel_split split(count, sizeof(value_type),
+                                     pool.concurrency());
+
+        if (split.chunks <= 1)
+        {
+            // Too small to be worth splitting
+            try
+            {
+                for (size_type i = 0; i < count; ++i, ++this->_finish)
+                    construct(this->_finish, i);
+            }
+            catch (...)
+            {
+                _release();
+                throw;
+            }
+
             return;
+        }
 
-        for (auto curr = begin(); curr != end(); ++curr)
-            // See
-            // https://stackoverflow.com/questions/14820307/when-to-use-addressofx-instead-of-x
-            traits_t::destroy(_alloc, std::addressof(*curr));
+        const std::unique_ptr<size_type[]> built(
+            new size_type[split.chunks]());
 
-        this->_finish = this->_start;
+        auto build_chunk = [&](size_type c) {
+            const size_type first = split.first(c);
+            const size_type last  = split.last(c, count);
+            size_type i           = first;
+
+            try
+            {
+                for (; i < last; ++i)
+                    construct(this->_start + i, i);
+            }
+            catch (...)
+            {
+                _destroy(this->_start + first, this->_start + i);
+                throw;
+            }
+
+            built[c] = last - first;
+        };
+
+        try
+        {
+            // A customized construct() may use allocator state that is not
+            // safe to share between threads.
+            if constexpr (__alloc_constructs_plainly<Alloc, Tp>)
+                pool.run(split.chunks, build_chunk);
+            else
+                for (size_type c = 0; c < split.chunks; ++c)
+                    build_chunk(c);
+        }
+        catch (...)
+        {
+            for (size_type c = 0; c < split.chunks; ++c)
+                _destroy(this->_start + split.first(c),
+                         this->_start + split.first(c) + built[c]);
+
+            _deallocate(this->_start, len);
+            this->_start  = pointer();
+            this->_finish = pointer();
+            this->_end    = pointer();
+            throw;
+        }
+
+        this->_finish = this->_start + count;
     }
 
-    iterator
-    insert(const_iterator pos, const_reference value)
+    template <typename... Args>
+    constexpr iterator
+    _insert(const_iterator pos, Args &&...args)
     {
-        const size_type n  = pos - begin();
-        const auto new_pos = begin() + (pos - cbegin());
+        const size_type n  = pos - cbegin();
+        const auto new_pos = begin() + n;
 
         // Enough space?
         if (_finish != _end)
@@ -559,75 +2924,86 @@ public:
             // Insert back?
             if (pos == cend())
             {
-                traits_t::construct(_alloc, _finish, value);
+                traits_t::construct(_alloc, _finish,
+                                    std::forward<Args>(args)...);
                 ++_finish;
+                _stats.template on_construct<Args &&...>(1);
             }
             // Shifting needed
             else
-                _shift_insert(new_pos, value);
+                _shift_insert(new_pos, std::forward<Args>(args)...);
         }
         // Reallocation needed
         else
         {
-            _realloc_insert(new_pos, value);
+            _realloc_insert(new_pos, std::forward<Args>(args)...);
         }
 
         return iterator(_start + n);
     }
 
-private:
-    allocator _alloc;
-    pointer _start;
-    pointer _finish;
-    pointer _end;
-
-    size_type
-    _check_len(size_type n, const char *s) const
+    template <typename... Args>
+    constexpr void
+    _shift_insert(const_iterator pos, Args &&...args)
     {
-        if (traits_t::max_size(_alloc) - size() < n)
-            std::__throw_length_error("New size exceeds max_size()");
-
-        const size_type len = size() + std::max(size(), n);
+        // Using an Args pack for forwarding for all types of passing (values,
+        // references, constructor arguments).
 
-        return (len < size() || len > traits_t::max_size(_alloc))
-                   ? traits_t::max_size(_alloc)
-                   : len;
-    }
+        const auto new_pos = begin() + (pos - cbegin());
 
-private:
-    void
-    _fill_initialize(size_type count, const_reference value)
-    {
-        this->_start  = traits_t::allocate(_alloc, count);
-        this->_finish = this->_start;
-        this->_end    = this->_start + count;
+        _stats.template on_construct<Args &&...>(1);
+        _stats.on_move(cend() - pos);
 
-        for (size_type i = 0; i < count; ++i)
-            traits_t::construct(_alloc, this->_finish++, value);
-    }
+        if (_relocating())
+        {
+            // Build the new element aside first: %args may refer to an element
+            // that is about to be shifted, and nothing has moved yet if the
+            // construction throws.
+            alignas(value_type) unsigned char buf[sizeof(value_type)];
+            pointer tmp = reinterpret_cast<pointer>(buf);
+            traits_t::construct(_alloc, tmp, std::forward<Args>(args)...);
+
+            //                   p                   _f
+            // ---------------------------------------------                  //
+            // | 0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | x | x | x |                  //
+            // ---------------------------------------------                  //
+            //                      v
+            // ---------------------------------------------                  //
+            // | 0 | 1 | 2 | 3 | ? | 4 | 5 | 6 | 7 | x | x |                  //
+            // ---------------------------------------------                  //
+            pointer p = new_pos.base();
+            _relocate(p, _finish, p + 1);
+            _relocate(tmp, tmp + 1, p);
+            ++_finish;
 
-    template <class InputIter>
-    void
-    _range_initialize(InputIter first, InputIter last)
-    {
-        size_type n   = std::distance(first, last);
-        this->_start  = traits_t::allocate(_alloc, n);
-        this->_finish = this->_start;
-        this->_end    = this->_start + n;
+            return;
+        }
 
-        for (auto it = first; it != last; ++it)
-            traits_t::construct(_alloc, this->_finish++, *it);
+        if constexpr (sizeof...(Args) == 1 &&
+                      (std::is_same<Args, value_type>::value && ...))
+        {
+            // An rvalue of value_type is assumed not to alias an element,
+            // like in std::vector, and is moved straight into place.
+            _shift_assign(new_pos.base(), std::forward<Args>(args)...);
+        }
+        else
+        {
+            // %args may refer to an element that is about to be shifted
+            value_type tmp(std::forward<Args>(args)...);
+            _shift_assign(new_pos.base(), std::move(tmp));
+        }
     }
 
-    template <typename Arg>
-    void
-    _shift_insert(const_iterator pos, Arg &&arg)
+    /**
+     * @brief Opens a slot at %pos by shifting the tail up by one, then
+     * move-assigns %value into it
+     *
+     * Every element moves, none is copied. If a move throws, the elements
+     * are all still valid but some may be in their moved-from state.
+     */
+    constexpr void
+    _shift_assign(pointer pos, value_type &&value)
     {
-        // Using Arg template for forwarding for all types of passing (values,
-        // reference, remove value).
-
-        const auto new_pos = begin() + (pos - cbegin());
-
         // Shift the last element to the right
         // ---------------------------------------------                      //
         // | 0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | x | x | x |                      //
@@ -637,35 +3013,26 @@ private:
         // ---------------------------------------------                      //
         // | 0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 7 | x | x |                      //
         // ---------------------------------------------                      //
-        traits_t::construct(_alloc, std::addressof(*_finish),
-                            std::move(*(_finish - 1)));
+        traits_t::construct(_alloc, _finish, std::move(*(_finish - 1)));
         ++_finish;
 
-        //                   f           l   e   _f
-        // ---------------------------------------------                      //
-        // | 0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 7 | x | x |                      //
-        // ---------------------------------------------                      //
-        pointer first = new_pos.base(); // First to shift
-        pointer last  = _finish - 2;    // Last to shift
-        pointer end   = _finish - 1;    // One-past last
-
-        //                 f = l e              _f
+        // Move the others up by one, from the back
+        //                 pos
         // ---------------------------------------------                      //
         // | 0 | 1 | 2 | 3 | 4 | 4 | 5 | 6 | 7 | x | x |                      //
         // ---------------------------------------------                      //
-        while (first != last)
-            *(--end) = *(--last);
+        std::move_backward(pos, _finish - 2, _finish - 1);
 
-        //                   f
+        //                 pos
         // ---------------------------------------------                      //
         // | 0 | 1 | 2 | 3 | a | 4 | 5 | 6 | 7 | x | x |                      //
         // ---------------------------------------------                      //
-        *new_pos = std::forward<Arg>(arg);
+        *pos = std::move(value);
     }
 
-    template <typename Arg>
-    void
-    _realloc_insert(iterator pos, Arg arg)
+    template <typename... Args>
+    constexpr void
+    _realloc_insert(iterator pos, Args &&...args)
     {
 
         pointer old_start  = this->_start;
@@ -678,13 +3045,31 @@ private:
         // | 0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 |                          //
         // -----------------------------------------                          //
 
+        size_type new_len = _check_len(1, "vector::insert");
+
+        if (_can_remap(new_len))
+        {
+            // %args may refer to an element, and the buffer may move
+            const difference_type i = pos - begin();
+            value_type tmp(std::forward<Args>(args)...);
+
+            _remap(new_len);
+            _shift_insert(cbegin() + i, std::move(tmp));
+            return;
+        }
+
         // Allocate a new array
-        const size_type new_len = _check_len(1, "vector::insert");
-        pointer new_start       = traits_t::allocate(_alloc, new_len);
-        pointer new_finish      = pointer();
+        pointer new_start  = _allocate(new_len);
+        pointer new_finish = pointer();
 
         const difference_type n = pos - begin();
 
+        if (old_start)
+            _stats.on_reallocate();
+
+        _stats.template on_construct<Args &&...>(1);
+        _on_realloc_transfer(old_finish - old_start);
+
         // (1)                                                                //
         // ---------------------------------------------                      //
         // | ? | ? | ? | ? | x | ? | ? | ? | ? | ? | ? |                      //
@@ -702,37 +3087,154 @@ private:
             // Construct first to accomodate catch block if there is an error
 
             // (1)
-            traits_t::construct(_alloc, new_start + n, std::forward<Arg>(arg));
-
-            // (2)
-            new_finish =
-                std::uninitialized_move(old_start, pos.base(), new_start);
-            ++new_finish;
-
-            // (3)
-            new_finish =
-                std::uninitialized_move(pos.base(), old_finish, new_finish);
+            traits_t::construct(_alloc, new_start + n,
+                                std::forward<Args>(args)...);
         }
         catch (...)
         {
-            if (!new_finish)
-                traits_t::destroy(_alloc, new_start + n);
-            else
-                for (auto curr = new_start; curr != new_finish; curr++)
-                    traits_t::destroy(_alloc, std::addressof(*curr));
+            _deallocate(new_start, new_len);
+            throw;
+        }
 
-            traits_t::deallocate(_alloc, new_start, new_len);
+        if (_relocating())
+        {
+            // (2) and (3) as two bulk copies. The old objects are gone after
+            // relocation, so there is nothing to destroy.
+            _relocate(old_start, pos.base(), new_start);
+            _relocate(pos.base(), old_finish, new_start + n + 1);
+            new_finish = new_start + (old_finish - old_start) + 1;
         }
+        else
+        {
+            try
+            {
+                // (2)
+                new_finish = _uninitialized_move_if_noexcept(
+                    old_start, pos.base(), new_start);
+                ++new_finish;
+
+                // (3)
+                new_finish = _uninitialized_move_if_noexcept(
+                    pos.base(), old_finish, new_finish);
+            }
+            catch (...)
+            {
+                if (!new_finish)
+                    traits_t::destroy(_alloc, new_start + n);
+                else
+                    for (auto curr = new_start; curr != new_finish; curr++)
+                        traits_t::destroy(_alloc, std::addressof(*curr));
+
+                _deallocate(new_start, new_len);
+                throw;
+            }
 
-        for (pointer curr = old_start; curr != old_finish; curr++)
-            traits_t::destroy(_alloc, std::addressof(*curr));
-        traits_t::deallocate(_alloc, old_start, _end - old_start);
+            for (pointer curr = old_start; curr != old_finish; curr++)
+                traits_t::destroy(_alloc, std::addressof(*curr));
+        }
+
+        _deallocate(old_start, old_end - old_start);
 
         this->_start  = new_start;
         this->_finish = new_finish;
         this->_end    = new_start + new_len;
     }
 };
+
+template <typename Tp, typename Alloc, typename Growth>
+constexpr void
+swap(vector<Tp, Alloc, Growth> &lhs,
+     vector<Tp, Alloc, Growth> &rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+/**
+ * @brief Removes every element for which %pred returns true
+ *
+ * The kept elements are compacted in one pass, keeping their order, and the
+ * tail is destroyed once. Returns the number of removed elements.
+ *
+ * simd_algorithm.h provides a vectorized overload for arithmetic element
+ * types.
+ */
+template <typename Tp, typename Alloc, typename Growth, typename Pred>
+constexpr typename vector<Tp, Alloc, Growth>::size_type
+erase_if(vector<Tp, Alloc, Growth> &v, Pred pred)
+{
+    const auto last = std::remove_if(v.begin(), v.end(), pred);
+    const auto n    = v.end() - last;
+
+    v.erase(last, v.end());
+
+    return n;
+}
+
+/**
+ * @brief Removes every element equal to %value
+ *
+ * Returns the number of removed elements.
+ */
+template <typename Tp, typename Alloc, typename Growth, typename Up>
+constexpr typename vector<Tp, Alloc, Growth>::size_type
+erase(vector<Tp, Alloc, Growth> &v, const Up &value)
+{
+    return erase_if(v, [&value](const Tp &x) { return x == value; });
+}
+
+/**
+ * @brief Copies the %N elements of %v into a std::array
+ *
+ * Tp must be default constructible. Throws std::length_error if v.size() is
+ * not %N, which is a compile error in constant evaluation.
+ */
+template <std::size_t N, typename Tp, typename Alloc, typename Growth>
+constexpr std::array<Tp, N>
+to_array(const vector<Tp, Alloc, Growth> &v)
+{
+    if (v.size() != N)
+        std::__throw_length_error("dutcpp::to_array");
+
+    std::array<Tp, N> result{};
+    std::copy(v.begin(), v.end(), result.begin());
+
+    return result;
+}
+
+/**
+ * @brief Builds a vector with %Make at compile time and returns its elements
+ * as a std::array
+ *
+ * %Make is a captureless lambda that returns a vector. It runs once to size
+ * the array and once to fill it, so a lookup table is computed by the same
+ * code that would build it at run time, without a separate size constant:
+ *
+ *     constexpr auto squares = dutcpp::to_array<[] {
+ *         dutcpp::vector<int> v;
+ *         for (int i = 0; i < 256; ++i)
+ *             v.push_back(i * i);
+ *         return v;
+ *     }>();
+ *
+ * As a constexpr variable, the array is emitted into read-only data and
+ * costs nothing at startup.
+ */
+template <auto Make>
+consteval auto
+to_array()
+{
+    constexpr std::size_t n = Make().size();
+    return to_array<n>(Make());
+}
+
+namespace pmr
+{
+/**
+ * @brief A vector that allocates from a std::pmr::memory_resource
+ */
+template <typename Tp, typename Growth = doubling_growth>
+using vector = dutcpp::vector<Tp, std::pmr::polymorphic_allocator<Tp>, Growth>;
+} // namespace pmr
 } // namespace dutcpp
 
 #endif
@@ -0,0 +1,724 @@
+/**
+ * @file vector_io.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Binary serialization of vector contents to files and streams
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * write() emits a vector_file_header followed by the payload:
+ *
+ *     +--------+---------+------------+------+----------+-------+---------+
+ *     | "DUTV" | version | byte order | size | reserved | tag   | count   |
+ *     | 4      | 2       | 2          | 4    | 4        | 8     | 8       |
+ *     +--------+---------+------------+------+----------+-------+---------+
+ *     | payload ...                                                       |
+ *     +-------------------------------------------------------------------+
+ *
+ * For trivially copyable types, the payload is the raw contents of the
+ * vector, written in one writev() call together with the header. Other types
+ * are encoded one element at a time with serializer<Tp> into a buffer of
+ * bounded size, which is written out as a chunk whenever it fills up:
+ *
+ *     +--------------+-------------------+--------------+-----
+ *     | chunk length | encoded elements  | chunk length | ...
+ *     | 4            | at most 64 KiB    | 4            |
+ *     +--------------+-------------------+--------------+-----
+ *
+ * An element may span two chunks. The framing lets the reader consume
+ * exactly the payload without knowing its total size in advance.
+ *
+ * read() checks the header against the destination type, which is named by
+ * a tag that is the same on every compiler and platform (see
+ * vector_type_tag()). Data written on a machine of the other byte order is
+ * converted for arithmetic types and the provided serializers, and rejected
+ * for other trivially copyable types.
+ *
+ * Counts in the file are not trusted to size allocations: the destination
+ * grows with the data actually read, at most doubling at each step, so a
+ * corrupt count ends in a std::runtime_error at the end of the data rather
+ * than in a huge allocation.
+ */
+
+#ifndef __DUTCPP_VECTOR_IO_H
+#define __DUTCPP_VECTOR_IO_H 1
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "vector.h"
+
+namespace dutcpp
+{
+struct vector_file_header
+{
+    char magic[4];              // "DUTV"
+    std::uint16_t version;      // 2
+    std::uint16_t byte_order;   // 0x0102 in the byte order of the writer
+    std::uint32_t element_size; // sizeof(Tp)
+    std::uint32_t reserved;     // 0
+    std::uint64_t type_tag;     // vector_type_tag() of the element type
+    std::uint64_t count;        // Number of elements
+};
+
+static_assert(sizeof(vector_file_header) == 32);
+
+/**
+ * @brief Encodes and decodes elements that are not trivially copyable
+ *
+ * Specializations provide
+ *
+ *     static constexpr std::uint64_t tag = ...;
+ *     template <typename Out> static void save(Out &out, const Tp &value);
+ *     template <typename In>  static Tp   load(In &in);
+ *
+ * where %tag names the encoding in the file header (any constant that never
+ * changes, such as a hash of a fixed name; see vector_type_tag()), %out has
+ * write(p, n) and write_scalar(x), and %in has read(p, n) and
+ * read_scalar<T>(), which takes care of the byte order. Counts decoded by
+ * load() must not size allocations on their own (see __read_step()).
+ */
+template <typename Tp>
+struct serializer;
+
+/**
+ * @brief Folds %s into the FNV-1a hash %h
+ */
+constexpr std::uint64_t
+__fnv1a(std::string_view s, std::uint64_t h = 0xcbf29ce484222325ull) noexcept
+{
+    for (const char c : s)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ull;
+    }
+
+    return h;
+}
+
+/**
+ * @brief Folds the 8 bytes of %v into the FNV-1a hash %h
+ */
+constexpr std::uint64_t
+__fnv1a(std::uint64_t v, std::uint64_t h) noexcept
+{
+    for (int i = 0; i < 8; ++i, v >>= 8)
+    {
+        h ^= v & 0xff;
+        h *= 0x100000001b3ull;
+    }
+
+    return h;
+}
+
+/**
+ * @brief Returns the tag that identifies %Tp in a vector_file_header
+ *
+ * Arithmetic types are named by their kind (bool, character, signed or
+ * unsigned integer, floating point) and size, so int32_t written on one
+ * platform reads back as int32_t on any other. Enumerations take the tag of
+ * their underlying type. Types with a serializer take serializer<Tp>::tag;
+ * a trivially copyable type can be named the same way by a serializer
+ * specialization that holds nothing but the tag. Any other type gets 0, and
+ * only its size is checked.
+ */
+template <typename Tp>
+constexpr std::uint64_t
+vector_type_tag() noexcept
+{
+    if constexpr (requires { serializer<Tp>::tag; })
+        return serializer<Tp>::tag;
+    else if constexpr (std::is_enum<Tp>::value)
+        return __fnv1a(vector_type_tag<std::underlying_type_t<Tp>>(),
+                       __fnv1a("enum"));
+    else if constexpr (std::is_same<Tp, bool>::value)
+        return __fnv1a(sizeof(Tp), __fnv1a("bool"));
+    else if constexpr (std::is_same<Tp, char>::value ||
+                       std::is_same<Tp, wchar_t>::value ||
+                       std::is_same<Tp, char8_t>::value ||
+                       std::is_same<Tp, char16_t>::value ||
+                       std::is_same<Tp, char32_t>::value)
+        return __fnv1a(sizeof(Tp), __fnv1a("char"));
+    else if constexpr (std::is_signed<Tp>::value && std::is_integral<Tp>::value)
+        return __fnv1a(sizeof(Tp), __fnv1a("int"));
+    else if constexpr (std::is_integral<Tp>::value)
+        return __fnv1a(sizeof(Tp), __fnv1a("uint"));
+    else if constexpr (std::is_floating_point<Tp>::value)
+        return __fnv1a(sizeof(Tp), __fnv1a("float"));
+    else
+        return 0;
+}
+
+/**
+ * @brief Returns how many more elements to make room for when %done of
+ * %count elements have been read
+ *
+ * The first step holds about 1 MiB, and each later one as many elements as
+ * are already read, so at most half of an allocation is ever unbacked by
+ * data from the file.
+ */
+template <typename Tp>
+constexpr std::size_t
+__read_step(std::uint64_t done, std::uint64_t count) noexcept
+{
+    constexpr std::uint64_t first = (std::uint64_t(1) << 20) / sizeof(Tp) + 1;
+
+    return std::size_t(std::min(count - done, std::max(done, first)));
+}
+
+template <typename Tp>
+inline Tp
+__byteswap(Tp value) noexcept
+{
+    unsigned char bytes[sizeof(Tp)];
+
+    std::memcpy(bytes, &value, sizeof(Tp));
+    std::reverse(bytes, bytes + sizeof(Tp));
+    std::memcpy(&value, bytes, sizeof(Tp));
+
+    return value;
+}
+
+/**
+ * @brief Writes length-prefixed chunks to a file descriptor or a stream
+ */
+template <typename Sink>
+class __output_buffer
+{
+public:
+    static constexpr std::size_t capacity = std::size_t(64) << 10;
+
+    explicit __output_buffer(Sink &sink)
+    : _sink(sink), _buffer(new char[_prefix + capacity]), _size(0)
+    {
+    }
+
+    void
+    write(const void *p, std::size_t n)
+    {
+        const char *c = static_cast<const char *>(p);
+
+        while (n > 0)
+        {
+            if (_size == capacity)
+                flush();
+
+            const std::size_t k = std::min(n, capacity - _size);
+            std::memcpy(_buffer.get() + _prefix + _size, c, k);
+
+            _size += k;
+            c += k;
+            n -= k;
+        }
+    }
+
+    template <typename Tp>
+    void
+    write_scalar(Tp value)
+    {
+        write(&value, sizeof(Tp));
+    }
+
+    /**
+     * @brief Writes out the pending bytes, if any, as one chunk
+     */
+    void
+    flush()
+    {
+        if (_size == 0)
+            return;
+
+        const std::uint32_t length = _size;
+        std::memcpy(_buffer.get(), &length, _prefix);
+
+        _sink.write(_buffer.get(), _prefix + _size);
+        _size = 0;
+    }
+
+private:
+    static constexpr std::size_t _prefix = sizeof(std::uint32_t);
+
+    Sink &_sink;
+    std::unique_ptr<char[]> _buffer;
+    std::size_t _size;
+};
+
+/**
+ * @brief Reads length-prefixed chunks from a file descriptor or a stream
+ */
+template <typename Source>
+class __input_buffer
+{
+public:
+    static constexpr std::size_t capacity = std::size_t(64) << 10;
+
+    __input_buffer(Source &source, bool swap_bytes)
+    : _source(source), _buffer(new char[capacity]), _pos(0), _size(0),
+      _swap(swap_bytes)
+    {
+    }
+
+    void
+    read(void *p, std::size_t n)
+    {
+        char *c = static_cast<char *>(p);
+
+        while (n > 0)
+        {
+            if (_pos == _size)
+                _refill();
+
+            const std::size_t k = std::min(n, _size - _pos);
+            std::memcpy(c, _buffer.get() + _pos, k);
+
+            _pos += k;
+            c += k;
+            n -= k;
+        }
+    }
+
+    template <typename Tp>
+    Tp
+    read_scalar()
+    {
+        Tp value;
+        read(&value, sizeof(Tp));
+
+        return _swap ? __byteswap(value) : value;
+    }
+
+    bool
+    swap_bytes() const noexcept
+    {
+        return _swap;
+    }
+
+private:
+    void
+    _refill()
+    {
+        std::uint32_t length;
+        _source.read(&length, sizeof(length));
+
+        if (_swap)
+            length = __byteswap(length);
+        if (length == 0 || length > capacity)
+            throw std::runtime_error("dutcpp::read: bad chunk length");
+
+        _source.read(_buffer.get(), length);
+        _pos  = 0;
+        _size = length;
+    }
+
+    Source &_source;
+    std::unique_ptr<char[]> _buffer;
+    std::size_t _pos;
+    std::size_t _size;
+    bool _swap;
+};
+
+template <typename Char, typename Traits, typename Alloc>
+struct serializer<std::basic_string<Char, Traits, Alloc>>
+{
+    using string_type = std::basic_string<Char, Traits, Alloc>;
+
+    static constexpr std::uint64_t tag =
+        __fnv1a(vector_type_tag<Char>(), __fnv1a("string"));
+
+    template <typename Out>
+    static void
+    save(Out &out, const string_type &s)
+    {
+        out.write_scalar(std::uint64_t(s.size()));
+        out.write(s.data(), s.size() * sizeof(Char));
+    }
+
+    template <typename In>
+    static string_type
+    load(In &in)
+    {
+        const std::uint64_t count = in.template read_scalar<std::uint64_t>();
+        string_type s;
+
+        for (std::uint64_t done = 0; done < count;)
+        {
+            const std::size_t k = __read_step<Char>(done, count);
+
+            s.resize(done + k);
+            in.read(s.data() + done, k * sizeof(Char));
+            done += k;
+        }
+
+        if (in.swap_bytes() && sizeof(Char) > 1)
+            for (Char &c : s)
+                c = __byteswap(c);
+
+        return s;
+    }
+};
+
+template <typename Tp, typename Alloc, typename Growth>
+struct serializer<vector<Tp, Alloc, Growth>>
+{
+    using vector_type = vector<Tp, Alloc, Growth>;
+
+    static constexpr std::uint64_t tag =
+        __fnv1a(vector_type_tag<Tp>(), __fnv1a("vector"));
+
+    template <typename Out>
+    static void
+    save(Out &out, const vector_type &v)
+    {
+        out.write_scalar(std::uint64_t(v.size()));
+
+        for (const auto &x : v)
+        {
+            if constexpr (std::is_trivially_copyable<Tp>::value)
+                out.write_scalar(x);
+            else
+                serializer<Tp>::save(out, x);
+        }
+    }
+
+    template <typename In>
+    static vector_type
+    load(In &in)
+    {
+        if (in.swap_bytes() && std::is_trivially_copyable<Tp>::value &&
+            !std::is_arithmetic<Tp>::value && sizeof(Tp) > 1)
+            throw std::runtime_error("dutcpp::read: cannot convert byte order");
+
+        const std::uint64_t count = in.template read_scalar<std::uint64_t>();
+        vector_type v;
+
+        v.reserve(__read_step<Tp>(0, count));
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            if constexpr (std::is_trivially_copyable<Tp>::value)
+                v.push_back(in.template read_scalar<Tp>());
+            else
+                v.push_back(serializer<Tp>::load(in));
+        }
+
+        return v;
+    }
+};
+
+struct __fd_sink
+{
+    int fd;
+
+    void
+    write(const void *p, std::size_t n)
+    {
+        const char *c = static_cast<const char *>(p);
+
+        while (n > 0)
+        {
+            const ssize_t k = ::write(fd, c, n);
+            if (k < 0 && errno == EINTR)
+                continue;
+            if (k < 0)
+                throw std::system_error(errno, std::generic_category(),
+                                        "dutcpp::write");
+
+            c += k;
+            n -= k;
+        }
+    }
+};
+
+struct __fd_source
+{
+    int fd;
+
+    void
+    read(void *p, std::size_t n)
+    {
+        char *c = static_cast<char *>(p);
+
+        while (n > 0)
+        {
+            const ssize_t k = ::read(fd, c, n);
+            if (k < 0 && errno == EINTR)
+                continue;
+            if (k < 0)
+                throw std::system_error(errno, std::generic_category(),
+                                        "dutcpp::read");
+            if (k == 0)
+                throw std::runtime_error("dutcpp::read: unexpected end of file");
+
+            c += k;
+            n -= k;
+        }
+    }
+};
+
+struct __ostream_sink
+{
+    std::ostream &os;
+
+    void
+    write(const void *p, std::size_t n)
+    {
+        if (!os.write(static_cast<const char *>(p), std::streamsize(n)))
+            throw std::ios_base::failure("dutcpp::write");
+    }
+};
+
+struct __istream_source
+{
+    std::istream &is;
+
+    void
+    read(void *p, std::size_t n)
+    {
+        if (!is.read(static_cast<char *>(p), std::streamsize(n)))
+            throw std::runtime_error("dutcpp::read: unexpected end of stream");
+    }
+};
+
+template <typename Tp>
+inline vector_file_header
+__make_header(std::size_t count)
+{
+    vector_file_header h;
+
+    std::memcpy(h.magic, "DUTV", 4);
+    h.version      = 2;
+    h.byte_order   = 0x0102;
+    h.element_size = sizeof(Tp);
+    h.reserved     = 0;
+    h.type_tag     = vector_type_tag<Tp>();
+    h.count        = count;
+
+    return h;
+}
+
+/**
+ * @brief Validates %h for elements of type %Tp
+ *
+ * Converts the fields to the native byte order and returns whether the
+ * payload has to be converted as well.
+ */
+template <typename Tp>
+inline bool
+__check_header(vector_file_header &h)
+{
+    if (std::memcmp(h.magic, "DUTV", 4) != 0)
+        throw std::runtime_error("dutcpp::read: not a vector file");
+
+    const bool swap_bytes = (h.byte_order == 0x0201);
+    if (swap_bytes)
+    {
+        h.version      = __byteswap(h.version);
+        h.element_size = __byteswap(h.element_size);
+        h.type_tag     = __byteswap(h.type_tag);
+        h.count        = __byteswap(h.count);
+    }
+    else if (h.byte_order != 0x0102)
+        throw std::runtime_error("dutcpp::read: bad byte order mark");
+
+    if (h.version != 2)
+        throw std::runtime_error("dutcpp::read: unsupported version");
+
+    if (h.element_size != sizeof(Tp) || h.type_tag != vector_type_tag<Tp>())
+        throw std::runtime_error("dutcpp::read: element type mismatch");
+
+    if (swap_bytes && std::is_trivially_copyable<Tp>::value &&
+        !std::is_arithmetic<Tp>::value && sizeof(Tp) > 1)
+        throw std::runtime_error("dutcpp::read: cannot convert byte order");
+
+    return swap_bytes;
+}
+
+template <typename Tp, typename Alloc, typename Growth, typename Sink>
+inline void
+__write_elements(Sink &sink, const vector<Tp, Alloc, Growth> &v)
+{
+    __output_buffer<Sink> out(sink);
+
+    for (const auto &x : v)
+        serializer<Tp>::save(out, x);
+
+    out.flush();
+}
+
+/**
+ * @brief Reads the payload described by %h into %v, which must be empty
+ */
+template <typename Tp, typename Alloc, typename Growth, typename Source>
+inline void
+__read_elements(Source &source, vector<Tp, Alloc, Growth> &v,
+                const vector_file_header &h, bool swap_bytes)
+{
+    if (h.count > v.max_size())
+        throw std::runtime_error("dutcpp::read: bad element count");
+
+    if constexpr (std::is_trivially_copyable<Tp>::value)
+    {
+        // The payload overwrites every element, no need to zero them first
+        for (std::uint64_t done = 0; done < h.count;)
+        {
+            const std::size_t k = __read_step<Tp>(done, h.count);
+
+            v.resize_for_overwrite(done + k);
+            source.read(v.data() + done, k * sizeof(Tp));
+            done += k;
+        }
+
+        if constexpr (std::is_arithmetic<Tp>::value && sizeof(Tp) > 1)
+            if (swap_bytes)
+                for (auto &x : v)
+                    x = __byteswap(x);
+    }
+    else
+    {
+        __input_buffer<Source> in(source, swap_bytes);
+
+        v.reserve(__read_step<Tp>(0, h.count));
+        for (std::uint64_t i = 0; i < h.count; ++i)
+            v.push_back(serializer<Tp>::load(in));
+    }
+}
+
+/**
+ * @brief Writes the contents of %v to the file descriptor %fd
+ *
+ * Trivially copyable elements go out with the header in a single writev()
+ * call (repeated only if the kernel accepts part of it). Throws
+ * std::system_error if writing fails.
+ */
+template <typename Tp, typename Alloc, typename Growth>
+void
+write(int fd, const vector<Tp, Alloc, Growth> &v)
+{
+    const vector_file_header h = __make_header<Tp>(v.size());
+    __fd_sink sink{fd};
+
+    if constexpr (std::is_trivially_copyable<Tp>::value)
+    {
+        iovec iov[2] = {
+            {const_cast<vector_file_header *>(&h), sizeof(h)},
+            {const_cast<Tp *>(v.data()), v.size() * sizeof(Tp)},
+        };
+        iovec *curr = iov;
+        int left    = iov[1].iov_len ? 2 : 1;
+
+        while (left > 0)
+        {
+            ssize_t k = ::writev(fd, curr, left);
+            if (k < 0 && errno == EINTR)
+                continue;
+            if (k < 0)
+                throw std::system_error(errno, std::generic_category(),
+                                        "dutcpp::write");
+
+            for (; left > 0 && std::size_t(k) >= curr->iov_len; ++curr, --left)
+                k -= curr->iov_len;
+
+            if (left > 0)
+            {
+                curr->iov_base = static_cast<char *>(curr->iov_base) + k;
+                curr->iov_len -= k;
+            }
+        }
+    }
+    else
+    {
+        sink.write(&h, sizeof(h));
+        __write_elements(sink, v);
+    }
+}
+
+/**
+ * @brief Writes the contents of %v to %os
+ *
+ * Throws std::ios_base::failure if the stream fails.
+ */
+template <typename Tp, typename Alloc, typename Growth>
+void
+write(std::ostream &os, const vector<Tp, Alloc, Growth> &v)
+{
+    const vector_file_header h = __make_header<Tp>(v.size());
+    __ostream_sink sink{os};
+
+    sink.write(&h, sizeof(h));
+
+    if constexpr (std::is_trivially_copyable<Tp>::value)
+        sink.write(v.data(), v.size() * sizeof(Tp));
+    else
+        __write_elements(sink, v);
+}
+
+/**
+ * @brief Replaces the contents of %v with a vector read from %fd
+ *
+ * Throws std::runtime_error if the data is malformed or holds another
+ * element type, and std::system_error if reading fails. %v is left empty on
+ * failure.
+ */
+template <typename Tp, typename Alloc, typename Growth>
+void
+read(int fd, vector<Tp, Alloc, Growth> &v)
+{
+    __fd_source source{fd};
+    vector_file_header h;
+
+    v.clear();
+    source.read(&h, sizeof(h));
+    const bool swap_bytes = __check_header<Tp>(h);
+
+    try
+    {
+        __read_elements(source, v, h, swap_bytes);
+    }
+    catch (...)
+    {
+        v.clear();
+        throw;
+    }
+}
+
+/**
+ * @brief Replaces the contents of %v with a vector read from %is
+ *
+ * %is must be positioned at a header written by write(). Reading stops
+ * right after the payload, so several vectors can be stored back to back.
+ */
+template <typename Tp, typename Alloc, typename Growth>
+void
+read(std::istream &is, vector<Tp, Alloc, Growth> &v)
+{
+    __istream_source source{is};
+    vector_file_header h;
+
+    v.clear();
+    source.read(&h, sizeof(h));
+    const bool swap_bytes = __check_header<Tp>(h);
+
+    try
+    {
+        __read_elements(source, v, h, swap_bytes);
+    }
+    catch (...)
+    {
+        v.clear();
+        throw;
+    }
+}
+} // namespace dutcpp
+
+#endif
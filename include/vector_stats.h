@@ -0,0 +1,378 @@
+/**
+ * @file vector_stats.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Opt-in allocation, copy, move and growth counters for vector
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Counting is enabled by defining DUTCPP_VECTOR_STATS before including
+ * vector.h (or by configuring CMake with -DDUTCPP_VECTOR_STATS=ON). Without
+ * it, the recorder embedded in every vector is an empty object with empty
+ * member functions, so nothing is stored or counted.
+ *
+ * Each vector counts its own events. When it is destroyed, its counters are
+ * added to the entry of vector_stats_registry named after its label (set with
+ * vector::set_stats_label(), defaults to the element type). The registry
+ * only exists when counting is enabled.
+ */
+
+#ifndef __DUTCPP_VECTOR_STATS_H
+#define __DUTCPP_VECTOR_STATS_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#ifdef DUTCPP_VECTOR_STATS
+#include <map>
+#include <mutex>
+#include <typeinfo>
+
+#if defined(__GNUG__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+#endif
+
+namespace dutcpp
+{
+/**
+ * @brief Counters collected for one vector, or summed over many
+ */
+struct vector_stats
+{
+    std::size_t instances            = 0; // Vectors merged into these counters
+    std::size_t allocations          = 0;
+    std::size_t bytes_allocated      = 0;
+    std::size_t reallocations        = 0; // Buffers replaced by a larger one
+    std::size_t elements_copied      = 0;
+    std::size_t elements_moved       = 0; // Includes byte-wise relocation
+    std::size_t elements_constructed = 0; // Built in place from other args
+    std::size_t peak_capacity        = 0;
+    std::size_t wasted_capacity      = 0; // capacity() - size() at destruction
+
+    /**
+     * @brief Adds the counters of %other to these
+     *
+     * Sums every counter except peak_capacity, which keeps the maximum.
+     */
+    void
+    merge(const vector_stats &other) noexcept
+    {
+        instances += other.instances;
+        allocations += other.allocations;
+        bytes_allocated += other.bytes_allocated;
+        reallocations += other.reallocations;
+        elements_copied += other.elements_copied;
+        elements_moved += other.elements_moved;
+        elements_constructed += other.elements_constructed;
+        peak_capacity = std::max(peak_capacity, other.peak_capacity);
+        wasted_capacity += other.wasted_capacity;
+    }
+
+    /**
+     * @brief Writes the counters as a JSON object
+     */
+    void
+    write_json(std::ostream &os) const
+    {
+        os << to_json();
+    }
+
+    std::string
+    to_json() const
+    {
+        using std::to_string;
+
+        return "{\"instances\": " + to_string(instances) +
+               ", \"allocations\": " + to_string(allocations) +
+               ", \"bytes_allocated\": " + to_string(bytes_allocated) +
+               ", \"reallocations\": " + to_string(reallocations) +
+               ", \"elements_copied\": " + to_string(elements_copied) +
+               ", \"elements_moved\": " + to_string(elements_moved) +
+               ", \"elements_constructed\": " +
+               to_string(elements_constructed) +
+               ", \"peak_capacity\": " + to_string(peak_capacity) +
+               ", \"wasted_capacity\": " + to_string(wasted_capacity) + "}";
+    }
+};
+
+#ifdef DUTCPP_VECTOR_STATS
+
+/**
+ * @brief Process-wide table of vector_stats, one entry per label
+ */
+class vector_stats_registry
+{
+public:
+    /**
+     * @brief Returns the registry
+     *
+     * The registry is never destroyed, so vectors with static storage
+     * duration can still report to it at exit.
+     */
+    static vector_stats_registry &
+    instance()
+    {
+        static vector_stats_registry *registry = new vector_stats_registry();
+        return *registry;
+    }
+
+    /**
+     * @brief Adds %stats to the entry named %label
+     */
+    void
+    record(const std::string &label, const vector_stats &stats)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries[label].merge(stats);
+    }
+
+    /**
+     * @brief Returns a copy of all entries
+     */
+    std::map<std::string, vector_stats>
+    snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries;
+    }
+
+    /**
+     * @brief Drops all entries
+     */
+    void
+    reset()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+    }
+
+    /**
+     * @brief Writes all entries as a JSON object keyed by label
+     */
+    void
+    write_json(std::ostream &os) const
+    {
+        os << to_json();
+    }
+
+    std::string
+    to_json() const
+    {
+        const auto entries = snapshot();
+        std::string json   = "{";
+        bool first         = true;
+
+        for (const auto &[label, stats] : entries)
+        {
+            json += (first ? "\n  \"" : ",\n  \"") + label + "\": ";
+            json += stats.to_json();
+            first = false;
+        }
+
+        return json + "\n}\n";
+    }
+
+private:
+    vector_stats_registry() = default;
+
+    mutable std::mutex _mutex;
+    std::map<std::string, vector_stats> _entries;
+};
+
+/**
+ * @brief Returns a readable name for type %Tp
+ */
+template <typename Tp>
+inline std::string
+__type_name()
+{
+    const char *name = typeid(Tp).name();
+
+#if defined(__GNUG__)
+    int status = 0;
+    char *demangled =
+        abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+    if (status == 0 && demangled)
+    {
+        std::string result(demangled);
+        std::free(demangled);
+        return result;
+    }
+#endif
+
+    return name;
+}
+
+/**
+ * @brief Per-vector event counters
+ *
+ * A vector calls the on_*() hooks from its allocation, construction and
+ * growth paths. A copied or moved-to vector starts with fresh counters and
+ * the default label.
+ */
+template <typename Tp>
+class __vector_stats_recorder
+{
+public:
+    constexpr __vector_stats_recorder() noexcept : _label(nullptr)
+    {
+        _stats.instances = 1;
+    }
+
+    constexpr __vector_stats_recorder(
+        const __vector_stats_recorder &other) noexcept
+    : __vector_stats_recorder()
+    {
+        _label = other._label;
+    }
+
+    constexpr __vector_stats_recorder &
+    operator=(const __vector_stats_recorder &) noexcept
+    {
+        return *this;
+    }
+
+    constexpr void
+    on_allocate(std::size_t n) noexcept
+    {
+        ++_stats.allocations;
+        _stats.bytes_allocated += n * sizeof(Tp);
+        _stats.peak_capacity = std::max(_stats.peak_capacity, n);
+    }
+
+    constexpr void
+    on_reallocate() noexcept
+    {
+        ++_stats.reallocations;
+    }
+
+    constexpr void
+    on_copy(std::size_t n) noexcept
+    {
+        _stats.elements_copied += n;
+    }
+
+    constexpr void
+    on_move(std::size_t n) noexcept
+    {
+        _stats.elements_moved += n;
+    }
+
+    /**
+     * @brief Counts %n elements constructed from arguments of types %Args
+     *
+     * A single argument of type Tp counts as a copy if it is an lvalue and as
+     * a move otherwise. Anything else counts as constructed in place.
+     */
+    template <typename... Args>
+    constexpr void
+    on_construct(std::size_t n) noexcept
+    {
+        if constexpr (sizeof...(Args) == 1 &&
+                      (std::is_same_v<std::remove_cvref_t<Args>, Tp> && ...))
+        {
+            if constexpr ((std::is_lvalue_reference_v<Args> && ...))
+                _stats.elements_copied += n;
+            else
+                _stats.elements_moved += n;
+        }
+        else
+            _stats.elements_constructed += n;
+    }
+
+    /**
+     * @brief Records the final state and reports to the registry
+     */
+    void
+    on_destroy(std::size_t size, std::size_t capacity)
+    {
+        _stats.wasted_capacity += capacity - size;
+
+        try
+        {
+            vector_stats_registry::instance().record(
+                _label ? std::string(_label) : __type_name<Tp>(), _stats);
+        }
+        catch (...)
+        {
+            // Telemetry must never take the program down.
+        }
+    }
+
+    constexpr void
+    set_label(const char *label) noexcept
+    {
+        _label = label;
+    }
+
+    constexpr const vector_stats &
+    get() const noexcept
+    {
+        return _stats;
+    }
+
+private:
+    const char *_label;
+    vector_stats _stats;
+};
+
+#else
+
+template <typename Tp>
+class __vector_stats_recorder
+{
+public:
+    constexpr void
+    on_allocate(std::size_t) noexcept
+    {
+    }
+
+    constexpr void
+    on_reallocate() noexcept
+    {
+    }
+
+    constexpr void
+    on_copy(std::size_t) noexcept
+    {
+    }
+
+    constexpr void
+    on_move(std::size_t) noexcept
+    {
+    }
+
+    template <typename... Args>
+    constexpr void
+    on_construct(std::size_t) noexcept
+    {
+    }
+
+    constexpr void
+    on_destroy(std::size_t, std::size_t) noexcept
+    {
+    }
+
+    constexpr void
+    set_label(const char *) noexcept
+    {
+    }
+
+    constexpr vector_stats
+    get() const noexcept
+    {
+        return vector_stats();
+    }
+};
+
+#endif
+} // namespace dutcpp
+
+#endif
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <vector>
 
+#include "include/devector.h"
 #include "include/vector.h"
 
 int
@@ -37,13 +38,7 @@ main(void)
     }
     std::cout << "\n";
 
-    v5.insert(v5.begin(), 3);
-    v5.insert(v5.begin(), 3);
-    v5.insert(v5.begin(), 3);
-    v5.insert(v5.begin(), 3);
-    v5.insert(v5.begin(), 3);
-    v5.insert(v5.begin(), 3);
-    v5.insert(v5.begin(), 3);
+    v5.insert(v5.begin(), 7, 3);
 
     v5.insert(v5.begin() + 7, -1);
 
@@ -53,5 +48,19 @@ main(void)
     }
     std::cout << "\n";
 
+    // Front insertion without shifting: devector keeps room before begin().
+    dutcpp::devector<int> d5(v4.begin(), v4.end());
+
+    for (int i = 0; i < 7; ++i)
+        d5.push_front(3);
+
+    d5.insert(d5.begin() + 7, -1);
+
+    for (auto curr = d5.cbegin(); curr != d5.cend(); ++curr)
+    {
+        std::cout << *curr << " ";
+    }
+    std::cout << "\n";
+
     return 0;
 }
@@ -0,0 +1,112 @@
+/**
+ * @file soa_vector_realloc.cpp
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Checks that a failed soa_vector reallocation leaves it unchanged
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#include "soa_vector.h"
+#include "test.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+/**
+ * @brief Copyable element whose move may throw and whose copy throws on
+ * demand
+ */
+struct thrower
+{
+    static inline int copies   = 0;
+    static inline int throw_at = -1;
+
+    int value;
+
+    thrower(int v) : value(v) { }
+
+    thrower(const thrower &other) : value(other.value)
+    {
+        if (copies++ == throw_at)
+            throw std::runtime_error("thrower: copy failed");
+    }
+
+    thrower(thrower &&other) noexcept(false) : value(other.value) { }
+
+    thrower &operator=(const thrower &) = default;
+};
+
+std::string
+name(int i)
+{
+    // Longer than the small-string buffer, so a moved-from string is empty
+    return std::string(32, static_cast<char>('a' + i));
+}
+
+void
+throw_from_second_column()
+{
+    dutcpp::soa_vector<std::string, thrower> v;
+
+    for (int i = 0; i < 4; ++i)
+        v.emplace_back(name(i), thrower(i));
+
+    thrower::copies   = 0;
+    thrower::throw_at = 2;
+
+    bool thrown = false;
+
+    try
+    {
+        v.reserve(v.capacity() + 64);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+    CHECK(v.size() == 4);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(v.column<0>()[i] == name(i));
+        CHECK(v.column<1>()[i].value == i);
+    }
+
+    thrower::throw_at = -1;
+    v.reserve(v.capacity() + 64);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(v.column<0>()[i] == name(i));
+        CHECK(v.column<1>()[i].value == i);
+    }
+}
+
+void
+move_when_every_column_can()
+{
+    dutcpp::soa_vector<std::string, int> v;
+
+    for (int i = 0; i < 1000; ++i)
+        v.emplace_back(std::to_string(i), i);
+
+    CHECK(v.size() == 1000);
+    CHECK(v.column<0>()[999] == "999");
+    CHECK(v.column<1>()[999] == 999);
+}
+} // namespace
+
+int
+main()
+{
+    throw_from_second_column();
+    move_when_every_column_can();
+
+    return test::result();
+}
@@ -0,0 +1,47 @@
+/**
+ * @file test.h
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Minimal checks shared by the test programs
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * Tests are built in Release like everything else, so they cannot rely on
+ * assert(). CHECK() reports a failure and keeps going; a test program returns
+ * test::result() from main(), which is nonzero if any check failed.
+ */
+
+#ifndef __DUTCPP_TEST_H
+#define __DUTCPP_TEST_H 1
+
+#include <cstdio>
+
+namespace test
+{
+inline int failures = 0;
+
+inline void
+check(bool ok, const char *expr, const char *file, int line)
+{
+    if (!ok)
+    {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+        ++failures;
+    }
+}
+
+inline int
+result()
+{
+    if (failures)
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+
+    return failures ? 1 : 0;
+}
+} // namespace test
+
+#define CHECK(expr)                                                           \
+    ::test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * @file vector_copy_count.cpp
+ * @author Richard Nguyen (richard@richardhnguyen.com)
+ * @brief Counts the element copies and allocations made by vector
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#include "vector.h"
+#include "test.h"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+/**
+ * @brief Element that counts its copies and moves
+ */
+struct counted
+{
+    static inline std::size_t copies = 0;
+    static inline std::size_t moves  = 0;
+
+    int value;
+
+    counted(int v = 0) noexcept : value(v) { }
+
+    counted(const counted &other) noexcept : value(other.value)
+    {
+        ++copies;
+    }
+
+    counted(counted &&other) noexcept : value(other.value)
+    {
+        ++moves;
+    }
+
+    counted &
+    operator=(const counted &other) noexcept
+    {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+
+    counted &
+    operator=(counted &&other) noexcept
+    {
+        value = other.value;
+        ++moves;
+        return *this;
+    }
+
+    ~counted() { }
+
+    static void
+    reset() noexcept
+    {
+        copies = 0;
+        moves  = 0;
+    }
+};
+
+/**
+ * @brief std::allocator that counts its allocations
+ */
+template <typename Tp>
+struct counting_allocator : std::allocator<Tp>
+{
+    static inline std::size_t allocations = 0;
+
+    template <typename Up>
+    struct rebind
+    {
+        using other = counting_allocator<Up>;
+    };
+
+    counting_allocator() noexcept = default;
+
+    template <typename Up>
+    counting_allocator(const counting_allocator<Up> &) noexcept
+    {
+    }
+
+    Tp *
+    allocate(std::size_t n)
+    {
+        ++allocations;
+        return std::allocator<Tp>::allocate(n);
+    }
+};
+
+using counted_vector = dutcpp::vector<counted, counting_allocator<counted>>;
+
+void
+rvalue_push_back_does_not_copy()
+{
+    counted_vector v;
+
+    counted::reset();
+
+    for (int i = 0; i < 1000; ++i)
+        v.push_back(counted(i));
+
+    CHECK(counted::copies == 0);
+    CHECK(v.size() == 1000);
+    CHECK(v[999].value == 999);
+}
+
+void
+rvalue_insert_does_not_copy()
+{
+    counted_vector v;
+
+    counted::reset();
+
+    // Front and middle, with and without spare capacity
+    for (int i = 0; i < 100; ++i)
+        v.insert(v.begin() + v.size() / 2, counted(i));
+
+    v.reserve(v.size() + 10);
+
+    for (int i = 0; i < 10; ++i)
+        v.insert(v.begin(), counted(i));
+
+    CHECK(counted::copies == 0);
+    CHECK(v.size() == 110);
+}
+
+void
+nested_vectors_move_on_growth()
+{
+    static_assert(std::is_nothrow_move_constructible<counted_vector>::value,
+                  "std::vector would copy a vector on growth");
+
+    std::vector<counted_vector> outer;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        counted_vector inner;
+
+        for (int j = 0; j < 10; ++j)
+            inner.emplace_back(j);
+
+        outer.push_back(std::move(inner));
+    }
+
+    counted::reset();
+
+    for (int i = 0; i < 100; ++i)
+        outer.emplace_back();
+
+    CHECK(counted::copies == 0);
+    CHECK(counted::moves == 0);
+    CHECK(outer[99].size() == 10);
+}
+
+void
+copy_assignment_reuses_buffer()
+{
+    counted_vector src;
+    counted_vector dst;
+
+    for (int i = 0; i < 100; ++i)
+        src.emplace_back(i);
+
+    dst.reserve(200);
+
+    for (int i = 0; i < 50; ++i)
+        dst.emplace_back(-i);
+
+    const counted *data           = dst.data();
+    const std::size_t allocations = counting_allocator<counted>::allocations;
+
+    counted::reset();
+    dst = src;
+
+    CHECK(dst.data() == data);
+    CHECK(counting_allocator<counted>::allocations == allocations);
+    CHECK(counted::copies == 100);
+    CHECK(dst.size() == 100);
+    CHECK(dst[99].value == 99);
+}
+
+void
+growing_assign_within_capacity()
+{
+    counted_vector src;
+    counted_vector dst;
+
+    for (int i = 0; i < 100; ++i)
+        src.emplace_back(i);
+
+    dst.reserve(200);
+
+    for (int i = 0; i < 30; ++i)
+        dst.emplace_back(-i);
+
+    const counted *data           = dst.data();
+    const std::size_t allocations = counting_allocator<counted>::allocations;
+    const std::size_t constructed = dst.stats().elements_copied;
+
+    counted::reset();
+    dst.assign(src.begin(), src.end());
+
+    CHECK(dst.data() == data);
+    CHECK(counting_allocator<counted>::allocations == allocations);
+    CHECK(counted::copies == 100);
+    CHECK(dst.size() == 100);
+    CHECK(dst[29].value == 29);
+    CHECK(dst[99].value == 99);
+
+#ifdef DUTCPP_VECTOR_STATS
+    // The 30 existing elements are assigned, the other 70 copy-constructed
+    CHECK(dst.stats().elements_copied - constructed == 70);
+#else
+    (void)constructed;
+#endif
+}
+} // namespace
+
+int
+main()
+{
+    rvalue_push_back_does_not_copy();
+    rvalue_insert_does_not_copy();
+    nested_vectors_move_on_growth();
+    copy_assignment_reuses_buffer();
+    growing_assign_within_capacity();
+
+    return test::result();
+}